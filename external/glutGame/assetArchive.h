@@ -0,0 +1,57 @@
+/*-------------------------------------------------------------------------\
+| File: ASSETARCHIVE.H														|
+| Desc: Provides declarations for a packed archive of the game's assets,	|
+|		memory mapped once and read through views into the mapping.			|
+| Definition File: ASSETARCHIVE.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _ASSET_ARCHIVE_H_
+#define _ASSET_ARCHIVE_H_
+
+#include <string>
+
+// Archive file, alongside the executable
+#define ASSET_ARCHIVE "assets.pak"
+
+// Directories (relative to the executable) packed into the archive
+#define ASSET_ARCHIVE_DIRS { "img", "sfx", "msc" }
+
+namespace GameFramework
+{
+	/* A packed asset, pointing straight into the mapped archive. Valid until the archive is closed. */
+	struct AssetView
+	{
+		const unsigned char* data;
+		unsigned int size;
+		unsigned long long modified; // Last write time of the file it was packed from
+	};
+
+	/* Assets are named by their path relative to the executable, e.g. "img/boardTexture.png" (case and slash direction
+	   don't matter). While the archive is open, lookups don't allocate or touch the file system; when it isn't, Find
+	   fails and callers fall back to the loose files. */
+	class AssetArchive
+	{
+	private:
+		static void* m_file;
+		static void* m_mapping;
+		static const unsigned char* m_base;
+		static unsigned int m_count;
+	public:
+		/* Maps the archive, returns false (leaving assets to be read as loose files) if it is missing or invalid */
+		static bool Open(const std::string& path);
+
+		/* Unmaps the archive, invalidating every view */
+		static void Close();
+
+		static bool IsOpen();
+
+		/* Finds an asset by path, or by directory and file name (as directory + "/" + name, without building it) */
+		static bool Find(const char* path, AssetView& view);
+		static bool Find(const char* directory, const char* name, AssetView& view);
+
+		/* Packs every file under ASSET_ARCHIVE_DIRS in root into an archive at path */
+		static bool Pack(const std::string& root, const std::string& path);
+	};
+}
+
+#endif // _ASSET_ARCHIVE_H_
@@ -0,0 +1,148 @@
+/*-------------------------------------------------------------------------\
+| File: AUDIO.H																|
+| Desc: Provides declarations for the game's audio, played by a			|
+|		swappable backend on an audio thread fed by a lock free queue.		|
+| Definition File: AUDIO.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _AUDIO_H_
+#define _AUDIO_H_
+
+#include "commandQueue.h"
+#include "uncopyable.h"
+#include <thread>
+#include <atomic>
+#include <string>
+
+// Commands the queue holds before further requests are dropped
+#define AUDIO_QUEUE_SIZE 256
+
+// Voices a sample plays on unless loaded with more, once all are busy the oldest is cut off
+#define AUDIO_SAMPLE_VOICES 4
+
+// Longest sound path a load command carries
+#define AUDIO_PATH_LENGTH 128
+
+// Defaults for AudioConfig, in milliseconds. Together they bound how long a sound takes from Play to the speaker.
+#define AUDIO_THREAD_PERIOD_MS 2  // Time the audio thread sleeps between servicing the queue
+#define AUDIO_DEVICE_BUFFER_MS 10 // Output device buffer (BASS_CONFIG_DEV_BUFFER)
+#define AUDIO_UPDATE_PERIOD_MS 5  // Period BASS refills stream buffers at (BASS_CONFIG_UPDATEPERIOD)
+
+// File the WAV backend writes what it plays to, in the working directory
+#define AUDIO_WAV_OUTPUT "audioOut.wav"
+
+namespace GameFramework
+{
+	/* Names a loaded sound, 0 for none. Issued straight away by a load; the sound itself is loaded on the audio thread. */
+	typedef unsigned int SoundID;
+
+	enum class AudioBackendType
+	{
+		BASS,	  // Plays through the default output device
+		Null,	  // Accepts every request and plays nothing
+		WavWriter // Mixes everything played into AUDIO_WAV_OUTPUT, in real time, for checking offline
+	};
+
+	enum class AudioCommandType
+	{
+		LoadSample,
+		LoadMusic,
+		Play,
+		Stop
+	};
+
+	/* Buffering and timing the audio thread and backend run with, 0 leaving a backend setting at the library's default */
+	struct AudioConfig
+	{
+		unsigned int threadPeriodMs;
+		unsigned int deviceBufferMs;
+		unsigned int updatePeriodMs;
+
+		AudioConfig() : threadPeriodMs(AUDIO_THREAD_PERIOD_MS), deviceBufferMs(AUDIO_DEVICE_BUFFER_MS), updatePeriodMs(AUDIO_UPDATE_PERIOD_MS) { }
+	};
+
+	struct AudioCommand
+	{
+		AudioCommandType type;
+		SoundID sound;
+		char path[AUDIO_PATH_LENGTH]; // Loads only
+		unsigned int voices;		  // LoadSample only
+	};
+
+	/* Does the work of playing sounds. Init and Shutdown are called by the thread starting and stopping audio, everything
+	   else on the audio thread. Paths are relative to the working directory, and are read from the asset archive when it
+	   holds them. */
+	class AudioBackend : private Uncopyable
+	{
+	public:
+		virtual ~AudioBackend() { }
+
+		/* Returns false if the backend can't play, in which case the null backend is used instead */
+		virtual bool Init() = 0;
+		virtual void Shutdown() = 0;
+
+		/* Samples are decoded whole, and play on up to voices channels at once. Music is streamed and loops until stopped. */
+		virtual void LoadSample(SoundID sound, const char* path, unsigned int voices) = 0;
+		virtual void LoadMusic(SoundID sound, const char* path) = 0;
+
+		/* Playing a sample starts it on a free voice, or on the one that has played longest if all are busy. Playing music
+		   restarts it. Stopping a sample stops all its voices. */
+		virtual void Play(SoundID sound) = 0;
+		virtual void Stop(SoundID sound) = 0;
+
+		/* Called each time the audio thread wakes, after the queue is drained */
+		virtual void Update() { }
+	};
+
+	class NullAudioBackend : public AudioBackend
+	{
+	public:
+		virtual bool Init() override { return true; }
+		virtual void Shutdown() override { }
+		virtual void LoadSample(SoundID sound, const char* path, unsigned int voices) override { }
+		virtual void LoadMusic(SoundID sound, const char* path) override { }
+		virtual void Play(SoundID sound) override { }
+		virtual void Stop(SoundID sound) override { }
+	};
+
+	/* Requests are queued from any thread and carried out by the backend on the audio thread, so callers (the
+	   simulation loop included) never wait on the audio library. */
+	class Audio
+	{
+	private:
+		static AudioBackend* m_backend;
+		static AudioBackendType m_type;
+		static AudioConfig m_config;
+		static CommandQueue<AudioCommand, AUDIO_QUEUE_SIZE> m_commands;
+		static std::thread m_thread;
+		static std::atomic<bool> m_running;
+		static std::atomic<SoundID> m_nextSound;
+
+		/* Carries out queued commands until Shutdown. A sound played more than once in one drain (say, by two bumpers hit
+		   in the same frame) is only started once, so a burst of identical triggers costs one voice. */
+		static void ThreadLoop();
+		static void Execute(const AudioCommand& command);
+
+		static bool Push(AudioCommandType type, SoundID sound, const char* path = nullptr, unsigned int voices = 0);
+	public:
+		/* Starts the audio thread on a backend, falling back to the null backend if it can't start */
+		static void Init(AudioBackendType type, const AudioConfig& config = AudioConfig());
+
+		/* Carries out any commands still queued, then stops the audio thread and the backend */
+		static void Shutdown();
+
+		static bool IsRunning();
+
+		/* Backend in use - Null if the one requested couldn't start */
+		static AudioBackendType Backend();
+
+		/* Queues a load, returning the sound's ID (0 if the queue is full or the path too long) */
+		static SoundID LoadSample(const char* path, unsigned int voices = AUDIO_SAMPLE_VOICES);
+		static SoundID LoadMusic(const char* path);
+
+		static void Play(SoundID sound);
+		static void Stop(SoundID sound);
+	};
+}
+
+#endif // _AUDIO_H_
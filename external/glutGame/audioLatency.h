@@ -0,0 +1,38 @@
+/*-------------------------------------------------------------------------\
+| File: AUDIOLATENCY.H														|
+| Desc: Provides declarations for a benchmark measuring the time from a	|
+|		sound being triggered to it starting in the audio output.			|
+| Definition File: AUDIOLATENCY.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _AUDIO_LATENCY_H_
+#define _AUDIO_LATENCY_H_
+
+#include "audio.h"
+
+// Benchmark report
+#define AUDIO_LATENCY_LOG "audioLatency.txt"
+
+// Click the benchmark plays, written to the working directory
+#define AUDIO_LATENCY_CLICK "latencyClick.wav"
+
+// Time between triggers, long enough for each click to finish first, in milliseconds
+#define AUDIO_LATENCY_INTERVAL_MS 50
+
+// Median latency above this fails the benchmark, in milliseconds
+#define AUDIO_LATENCY_LIMIT_MS 5.0
+
+namespace GameFramework
+{
+	/* Plays a click through the WAV writer backend at known times, the way a trigger callback plays a sound, then finds
+	   each click in the file written. The frame it starts on, against the time Play was called, is the latency of the
+	   queue, audio thread and backend together. Device latency comes on top with BASS, and is logged when it starts. */
+	class AudioLatencyBenchmark
+	{
+	public:
+		/* Returns 0 on success, 1 if the median latency is over AUDIO_LATENCY_LIMIT_MS, 2 if a click went missing */
+		static int Run(int hits, const AudioConfig& config = AudioConfig());
+	};
+}
+
+#endif // _AUDIO_LATENCY_H_
@@ -1,21 +1,23 @@
 /*
 	File: BACKGROUNDMUSIC.H
 	Author: Henri Keeble
-	Desc: Declares a background music class using BASS.
+	Desc: Declares a background music class, streaming and looping a track on the audio thread.
 */
 #ifndef _BACKGROUND_MUSIC_H_
 #define _BACKGROUND_MUSIC_H_
 
-#include "BASS\bass.h"
 #include "log.h"
-#include "sample.h"
+#include "audio.h"
 #include <string>
 
 namespace GameFramework
 {
-	class BackgroundMusic : public Sample
+	/* Streams a track, decoding it as it plays and looping it in the audio backend, so memory does not grow with the
+	   track's length and nothing needs polling. Copies share the stream; it is freed when audio shuts down. */
+	class BackgroundMusic
 	{
 	private:
+		SoundID stream;
 		bool isPlaying;
 	public:
 		BackgroundMusic();
@@ -24,13 +26,15 @@ namespace GameFramework
 		BackgroundMusic& operator=(const BackgroundMusic& param);
 		~BackgroundMusic();
 
-		/* Used to check if the current loop is finished */
-		void Update();
+		/* Queues the track to be opened, from the asset archive if it holds it or from the file */
+		void Load(const char* filename);
 
-		/* Play and stop overrides, as the isPlaying variable must be monitored and set */
-		virtual void Play() override final;
-		virtual void Stop() override final;
+		/* Plays the track from its start, looping until stopped */
+		void Play();
+		void Stop();
+
+		bool IsPlaying() const;
 	};
 }
 
-#endif // _BACKGROUND_MUSIC_H_
\ No newline at end of file
+#endif // _BACKGROUND_MUSIC_H_
@@ -0,0 +1,52 @@
+/*-------------------------------------------------------------------------\
+| File: BASSAUDIO.H															|
+| Desc: Provides declarations for an audio backend playing through BASS.	|
+| Definition File: BASSAUDIO.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _BASS_AUDIO_H_
+#define _BASS_AUDIO_H_
+
+#include "audio.h"
+#include "BASS\bass.h"
+#include <vector>
+
+// Playback buffer kept for music, in milliseconds. Only this much of the track is decoded ahead of playback.
+#define MUSIC_BUFFER_MS 250
+
+namespace GameFramework
+{
+	/* Samples are loaded whole with BASS_SampleLoad, BASS keeping their voices and overriding the longest playing when all
+	   are busy. Music is a looping stream, decoded as it plays. */
+	class BassAudioBackend : public AudioBackend
+	{
+	private:
+		struct BassSound
+		{
+			HSAMPLE sample;
+			HSTREAM stream;
+		};
+
+		/* Indexed by SoundID */
+		std::vector<BassSound> m_sounds;
+
+		/* Applied by Init, 0 for BASS's default */
+		unsigned int m_deviceBufferMs;
+		unsigned int m_updatePeriodMs;
+
+		BassSound* Find(SoundID sound);
+		BassSound& Add(SoundID sound);
+	public:
+		BassAudioBackend(unsigned int deviceBufferMs, unsigned int updatePeriodMs);
+
+		/* Sets the buffering up before starting the default device, and logs the device's reported latency */
+		virtual bool Init() override;
+		virtual void Shutdown() override;
+		virtual void LoadSample(SoundID sound, const char* path, unsigned int voices) override;
+		virtual void LoadMusic(SoundID sound, const char* path) override;
+		virtual void Play(SoundID sound) override;
+		virtual void Stop(SoundID sound) override;
+	};
+}
+
+#endif // _BASS_AUDIO_H_
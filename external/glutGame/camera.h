@@ -8,6 +8,11 @@
 #define _CAMERA_H_
 
 #include "globals.h"
+#include "frustum.h"
+
+// Clip plane distances of the perspective projection
+#define CAMERA_NEAR .1f
+#define CAMERA_FAR 100.f
 
 class Camera
 {
@@ -16,6 +21,13 @@ public:
 	Camera(Vec3 up, Vec3 lookAt, Vec3 eyePos, Fl32 FOV);
 	~Camera();
 	void Update();
+
+	/* Builds the view frustum for this camera's perspective projection */
+	GameFramework::Frustum GetFrustum(Fl32 aspect, Fl32 zNear = CAMERA_NEAR, Fl32 zFar = CAMERA_FAR) const;
+
+	/* The matrices Update and GLUTGame::UpdatePerspective load, for renderers without the fixed function matrix stack */
+	Mat44 GetViewMatrix() const;
+	Mat44 GetProjectionMatrix(Fl32 aspect, Fl32 zNear = CAMERA_NEAR, Fl32 zFar = CAMERA_FAR) const;
 	Vec3 Up, LookAt, EyePos;
 	Fl32 FOV;
 };
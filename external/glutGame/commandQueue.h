@@ -0,0 +1,85 @@
+/*-------------------------------------------------------------------------\
+| File: COMMANDQUEUE.H														|
+| Desc: Provides a bounded lock free queue, passing commands from any		|
+|		number of threads to one servicing thread.							|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _COMMAND_QUEUE_H_
+#define _COMMAND_QUEUE_H_
+
+#include <atomic>
+#include "uncopyable.h"
+
+namespace GameFramework
+{
+	/* Each slot carries a sequence number saying whose turn it is: a writer may fill it when the sequence equals its
+	   position, the reader may take it when it equals position + 1. Writers claim positions with a compare and swap, so
+	   neither side ever takes a lock or waits on the other. Capacity must be a power of two. */
+	template <typename T, unsigned int Capacity>
+	class CommandQueue : private Uncopyable
+	{
+	private:
+		static const unsigned int MASK = Capacity - 1;
+
+		struct Slot
+		{
+			std::atomic<unsigned int> sequence;
+			T value;
+		};
+
+		Slot m_slots[Capacity];
+
+		/* Next position to write, shared by every writer */
+		std::atomic<unsigned int> m_tail;
+
+		/* Next position to read, owned by the reader */
+		unsigned int m_head;
+	public:
+		CommandQueue() : m_tail(0), m_head(0)
+		{
+			static_assert((Capacity & MASK) == 0, "CommandQueue capacity must be a power of two");
+			for (unsigned int i = 0; i < Capacity; i++)
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/* Writer side, any thread - returns false (dropping the command) if the queue is full */
+		bool Push(const T& value)
+		{
+			unsigned int position = m_tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot& slot = m_slots[position & MASK];
+				int turn = (int)(slot.sequence.load(std::memory_order_acquire) - position);
+				if (turn == 0)
+				{
+					// The slot is free at this position, claim it unless another writer got there first
+					if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.value = value;
+						slot.sequence.store(position + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (turn < 0)
+					return false; // Full - the reader hasn't freed this slot yet
+				else
+					position = m_tail.load(std::memory_order_relaxed);
+			}
+		}
+
+		/* Reader side, one thread only - returns false if nothing is waiting */
+		bool Pop(T& value)
+		{
+			Slot& slot = m_slots[m_head & MASK];
+			if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+				return false;
+
+			value = slot.value;
+			slot.sequence.store(m_head + Capacity, std::memory_order_release);
+			m_head++;
+			return true;
+		}
+	};
+}
+
+#endif // _COMMAND_QUEUE_H_
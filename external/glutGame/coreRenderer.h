@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------\
+| File: CORERENDERER.H														|
+| Desc: Provides declarations for an OpenGL 3.3 core profile renderer,		|
+|		drawing frame snapshots with a single lit shader from vertex		|
+|		buffers uploaded once.												|
+| Definition File: CORERENDERER.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _CORE_RENDERER_H_
+#define _CORE_RENDERER_H_
+
+#include "globals.h"
+#include "glCore.h"
+#include "meshLOD.h"
+#include "frameSnapshot.h"
+#include "uncopyable.h"
+#include <map>
+
+namespace GameFramework
+{
+	/* Renderer used to draw a snapshot's shapes */
+	enum class RenderBackend
+	{
+		FixedFunction,	// GL 1.1 vertex arrays, using the fixed function matrix stack and lighting
+		Core			// GL 3.3 core features only - shaders, uniform buffers and vertex buffer objects
+	};
+
+	/* Per frame uniform block, laid out to match std140 */
+	struct FrameUniforms
+	{
+		Mat44 view;
+		Mat44 projection;
+		physx::PxVec4 lightDirection;	// Eye space, towards the light
+		physx::PxVec4 lighting;			// x - ambient, y - diffuse
+	};
+
+	/* A mesh's vertex array and buffers, resident on the GPU */
+	struct GpuMesh
+	{
+		GpuMesh() : vao(0), vbo(0), ibo(0), indexCount(0) { }
+
+		GLuint vao, vbo, ibo;
+		GLsizei indexCount;
+	};
+
+	class CoreRenderer : private Uncopyable
+	{
+	private:
+		bool m_ready;
+
+		/* Lit shader, and the locations of its per draw uniforms */
+		GLuint m_program;
+		GLint m_modelLoc, m_normalMatrixLoc, m_colorLoc;
+
+		/* Buffer backing the shader's Frame uniform block */
+		GLuint m_frameUniforms;
+
+		/* Meshes shared by every draw, uploaded in Init */
+		SphereLODSet m_sphereLODs;
+		GpuMesh m_cube;
+		GpuMesh m_spheres[SPHERE_LOD_COUNT];
+
+		/* Convex meshes, uploaded the first time each is drawn */
+		std::map<const physx::PxConvexMesh*, GpuMesh> m_convexMeshes;
+
+		bool BuildProgram();
+
+		/* Uploads an indexed triangle list into a new vertex array */
+		GpuMesh Upload(const std::vector<MeshVertex>& vertices, const std::vector<GLushort>& indices);
+
+		/* Returns the uploaded copy of a convex mesh, flat shaded */
+		const GpuMesh& ConvexMesh(const physx::PxConvexMesh* mesh);
+
+		void Draw(const GpuMesh& mesh, const Mat44& model, const Mat33& normalMatrix, const Vec3& color);
+
+		static void Release(GpuMesh& mesh);
+	public:
+		CoreRenderer();
+		~CoreRenderer();
+
+		/* Loads GL 3.3, builds the shader and uploads the shared meshes. Needs a current context, returns false if it lacks 3.3. */
+		bool Init();
+		bool IsReady() const;
+
+		/* Draws the snapshot's shapes, interpolated ones alpha of the way between steps, swapping in simplified hulls as
+		   GLUTGame::RenderGeometry does */
+		void Render(const FrameSnapshot& snapshot, Fl32 alpha, const Mat44& view, const Mat44& projection,
+			const std::map<const physx::PxConvexMesh*, physx::PxConvexMesh*>& simplifiedHulls);
+
+		/* Deletes the GL objects, while the context is still current */
+		void Shutdown();
+	};
+}
+
+#endif // _CORE_RENDERER_H_
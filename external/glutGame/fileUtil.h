@@ -0,0 +1,41 @@
+/*-------------------------------------------------------------------------\
+| File: FILEUTIL.H															|
+| Desc: Provides declarations for file helpers shared by the caches and	|
+|		build steps that write their own files.								|
+| Definition File: FILEUTIL.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FILE_UTIL_H_
+#define _FILE_UTIL_H_
+
+#include <string>
+#include <fstream>
+
+namespace GameFramework
+{
+	/* Last write time of a file, 0 if it doesn't exist */
+	unsigned long long ModifiedTime(const std::string& path);
+
+	/* A file written under a temporary name and moved over the real one by Commit, so a partly written file is never
+	   read. The temporary is removed if the write fails or Commit is never called. */
+	class AtomicFile
+	{
+	private:
+		std::string m_path;
+		std::string m_temporary;
+		std::ofstream m_stream;
+		bool m_committed;
+	public:
+		AtomicFile(const std::string& path);
+		~AtomicFile();
+
+		/* False if the temporary could not be opened */
+		bool IsOpen() const { return m_stream.is_open(); }
+		std::ofstream& Stream() { return m_stream; }
+
+		/* Replaces the real file with what was written, returns false (leaving it untouched) if any write failed */
+		bool Commit();
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMECAPTURE.H														|
+| Desc: Provides declarations for an asynchronous frame recorder, reading	|
+|		frames back through a ring of pixel buffer objects and writing		|
+|		them out on a background thread.									|
+| Definition File: FRAMECAPTURE.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FRAME_CAPTURE_H_
+#define _FRAME_CAPTURE_H_
+
+#include "glCore.h"
+#include "uncopyable.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Pixel buffers in flight - a frame is mapped this many frames after it is read, by when the GPU has long finished it
+#define CAPTURE_RING_SIZE 3
+
+// Frames waiting for the writer before capture either blocks (lossless) or drops frames
+#define CAPTURE_QUEUE_LIMIT 64
+
+namespace GameFramework
+{
+	enum class CaptureFormat
+	{
+		Raw,	// A single stream of top down BGRA frames
+		PNG		// One PNG per frame
+	};
+
+	/* A frame read back from the GPU, bottom row first, BGRA */
+	struct CapturedFrame
+	{
+		unsigned int number;
+		std::vector<unsigned char> pixels;
+	};
+
+	class FrameCapture : private Uncopyable
+	{
+	private:
+		bool m_capturing;
+		CaptureFormat m_format;
+		std::string m_directory;
+		int m_width, m_height;
+
+		/* Block rather than drop frames when the writer falls behind - for offscreen rendering, which can wait */
+		bool m_lossless;
+
+		/* Read back ring. Without GL 3.3, frames are read straight into client memory instead. */
+		bool m_usePBOs;
+		GLuint m_pbos[CAPTURE_RING_SIZE];
+		GLCore::GLsync m_fences[CAPTURE_RING_SIZE];
+		unsigned int m_frameNumbers[CAPTURE_RING_SIZE];
+		unsigned int m_framesRead;
+
+		/* Writer thread, and the frames queued for it */
+		std::thread m_writer;
+		std::mutex m_mutex;
+		std::condition_variable m_frameQueued;
+		std::condition_variable m_frameWritten;
+		std::deque<CapturedFrame> m_queue;
+		std::vector<std::vector<unsigned char> > m_freeBuffers;
+		bool m_stopping;
+
+		std::ofstream m_rawFile;
+		std::atomic<unsigned int> m_framesWritten;
+		unsigned int m_framesDropped;
+
+		/* Maps a ring slot's pixel buffer, once its fence has passed, and queues its frame */
+		void Collect(int slot);
+
+		/* A buffer sized for one frame, reused from written frames where possible */
+		std::vector<unsigned char> AcquireBuffer();
+
+		void Submit(unsigned int number, std::vector<unsigned char>& pixels);
+
+		void WriterLoop();
+		void Write(const CapturedFrame& frame);
+	public:
+		FrameCapture();
+		~FrameCapture();
+
+		/* Starts recording width x height frames into directory (created if needed). Needs a current GL context. */
+		bool Start(const std::string& directory, CaptureFormat format, int width, int height, bool lossless);
+
+		/* Reads back the frame just rendered, call before presenting it */
+		void Capture();
+
+		/* Collects the frames still in flight, waits for the writer to finish, and frees the pixel buffers */
+		void Stop();
+
+		bool IsCapturing() const;
+	};
+}
+
+#endif // _FRAME_CAPTURE_H_
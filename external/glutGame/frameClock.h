@@ -0,0 +1,57 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMECLOCK.H														|
+| Desc: Provides declarations for a wall clock frame timer and a frame		|
+|		pacer, used to limit the frame rate without spinning.				|
+| Definition File: FRAMECLOCK.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FRAME_CLOCK_H_
+#define _FRAME_CLOCK_H_
+
+#include <chrono>
+
+namespace GameFramework
+{
+	typedef std::chrono::steady_clock FrameClockType;
+
+	/* Measures wall time between frames */
+	class FrameClock
+	{
+	private:
+		FrameClockType::time_point m_last;
+	public:
+		FrameClock();
+		~FrameClock();
+
+		void Reset();
+
+		/* Returns the seconds elapsed since the last Tick (or Reset) */
+		double Tick();
+	};
+
+	/* Waits out the remainder of each frame, sleeping while the deadline is far off and yielding close to it */
+	class FramePacer
+	{
+	private:
+		double m_targetRate;
+		double m_refreshRate;
+		bool m_vsync;
+		FrameClockType::time_point m_nextDeadline;
+	public:
+		FramePacer(double targetRate);
+		~FramePacer();
+
+		/* Frames per second to pace to, 0 or less disables pacing */
+		void SetTargetRate(double targetRate);
+		double TargetRate() const;
+
+		/* When vsync is on and the target is at or above the refresh rate, the buffer swap paces frames instead */
+		void SetVSync(bool enabled, double refreshRate);
+		bool VSync() const;
+
+		/* Blocks until the next frame is due */
+		void Wait();
+	};
+}
+
+#endif // _FRAME_CLOCK_H_
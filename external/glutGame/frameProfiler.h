@@ -0,0 +1,106 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMEPROFILER.H														|
+| Desc: Provides declarations for a per phase frame profiler, recording		|
+|		frame timings into a ring buffer and reporting percentiles.			|
+| Definition File: FRAMEPROFILER.CPP										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FRAME_PROFILER_H_
+#define _FRAME_PROFILER_H_
+
+#include "globals.h"
+#include "frameClock.h"
+#include "uncopyable.h"
+#include "GL/glut.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Profile report file
+#define PROFILE_LOG "frameProfile.txt"
+
+// Number of frames kept in the ring buffer
+#define PROFILE_HISTORY 1024
+
+// Frame time graph dimensions, in pixels, and the frame time at the top of the graph
+#define PROFILE_GRAPH_HEIGHT 120
+#define PROFILE_GRAPH_MAX_MS 50.f
+
+namespace GameFramework
+{
+	/* Timed sections of a frame */
+	enum class ProfilePhase
+	{
+		Input,
+		Logic,
+		Physics,
+		Scene,
+		HUD,
+		Swap,
+		Count
+	};
+
+	/* Timings of a single frame, in milliseconds */
+	struct FrameSample
+	{
+		Fl32 phase[(int)ProfilePhase::Count];
+		Fl32 frame;
+	};
+
+	/* A single vertex of the frame graph, laid out for glInterleavedArrays(GL_C3F_V3F) */
+	struct GraphVertex
+	{
+		GLfloat r, g, b;
+		GLfloat x, y, z;
+	};
+
+	class FrameProfiler : private Uncopyable
+	{
+	private:
+		/* Ring buffer of finished frames. Written only by the thread ending frames, readable from any thread. */
+		FrameSample m_samples[PROFILE_HISTORY];
+		std::atomic<unsigned int> m_framesWritten;
+
+		/* Phase times accumulated for the frame in progress */
+		Fl32 m_current[(int)ProfilePhase::Count];
+		FrameClockType::time_point m_frameStart;
+		bool m_frameStarted;
+
+		/* Reused graph geometry */
+		std::vector<GraphVertex> m_graph;
+	public:
+		FrameProfiler();
+		~FrameProfiler();
+
+		/* Adds time to a phase of the current frame */
+		void Add(ProfilePhase phase, Fl32 milliseconds);
+
+		/* Commits the current frame to the ring buffer */
+		void EndFrame();
+
+		/* Copies the recorded frames, oldest first, into samples. Returns the number copied. */
+		unsigned int Snapshot(std::vector<FrameSample>& samples) const;
+
+		/* Builds a p50/p95/p99/max table of each phase over the recorded frames */
+		std::string Report() const;
+
+		/* Draws stacked per phase frame times along the bottom of the viewport, with a line at budgetMs */
+		void RenderGraph(Fl32 budgetMs);
+
+		static const char* PhaseName(ProfilePhase phase);
+	};
+
+	/* Times its own lifetime into a phase of the current frame */
+	class ProfileScope : private Uncopyable
+	{
+	private:
+		FrameProfiler& m_profiler;
+		ProfilePhase m_phase;
+		FrameClockType::time_point m_start;
+	public:
+		ProfileScope(FrameProfiler& profiler, ProfilePhase phase);
+		~ProfileScope();
+	};
+}
+
+#endif // _FRAME_PROFILER_H_
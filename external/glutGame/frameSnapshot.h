@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMESNAPSHOT.H														|
+| Desc: Provides declarations for an immutable copy of everything needed	|
+|		to draw a frame, captured from the simulation.						|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FRAME_SNAPSHOT_H_
+#define _FRAME_SNAPSHOT_H_
+
+#include "globals.h"
+#include "hud.h"
+#include "frameClock.h"
+#include <vector>
+
+namespace GameFramework
+{
+	/* A shape to draw, at its world pose */
+	struct ShapeDraw
+	{
+		Mat44 pose; // As of the latest physics step
+		physx::PxGeometryHolder geometry;
+		Vec3 color;
+		bool textured;
+
+		/* Set for a dynamic actor drawn interpolated - its previous and current step poses, and the shape's pose relative to it */
+		bool interpolated;
+		Transform previous, current, local;
+
+		/* World pose to draw at, alpha of the way from the previous step to the current one */
+		Mat44 PoseAt(Fl32 alpha) const
+		{
+			if (!interpolated)
+				return pose;
+
+			// Normalized lerp, taking the short way round
+			Quat qb = previous.q.dot(current.q) < 0 ? -current.q : current.q;
+			Quat q = (previous.q * (1 - alpha) + qb * alpha).getNormalized();
+
+			return Mat44(Transform(previous.p + (current.p - previous.p) * alpha, q) * local);
+		}
+	};
+
+	struct FrameSnapshot
+	{
+		FrameSnapshot() : state(0), clearColor(0.f), owed(0.f), stepTime(0.f) { }
+
+		/* Game defined state, e.g. which menu is showing */
+		int state;
+
+		Vec3 clearColor;
+		std::vector<ShapeDraw> shapes;
+		HUDSnapshot hud;
+
+		/* When it was captured, the simulated time then owed and the physics step length, in seconds */
+		FrameClockType::time_point captured;
+		Fl32 owed, stepTime;
+
+		/* How far between the previous and current steps the simulation is at now, by the renderer's own clock. Runs on
+		   past the capture, so frames drawn from the same snapshot still move on. */
+		Fl32 Alpha(FrameClockType::time_point now) const
+		{
+			if (stepTime <= 0.f)
+				return 1.f;
+
+			Fl32 alpha = (owed + std::chrono::duration<Fl32>(now - captured).count()) / stepTime;
+			return alpha < 0.f ? 0.f : alpha > 1.f ? 1.f : alpha;
+		}
+	};
+}
+
+#endif // _FRAME_SNAPSHOT_H_
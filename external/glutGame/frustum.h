@@ -0,0 +1,42 @@
+/*-------------------------------------------------------------------------\
+| File: FRUSTUM.H															|
+| Desc: Provides declarations for a view frustum, used to cull geometry		|
+|		outside the camera's view.											|
+| Definition File: FRUSTUM.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _FRUSTUM_H_
+#define _FRUSTUM_H_
+
+#include "globals.h"
+
+namespace GameFramework
+{
+	enum class FrustumPlane
+	{
+		Near,
+		Far,
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Count
+	};
+
+	/* Six planes with inward facing normals */
+	class Frustum
+	{
+	private:
+		physx::PxPlane m_planes[(int)FrustumPlane::Count];
+	public:
+		Frustum();
+		~Frustum();
+
+		void SetPlane(FrustumPlane plane, const physx::PxPlane& value);
+
+		/* Returns false only if bounds lie entirely outside one of the planes (so may be conservatively true) */
+		bool Intersects(const physx::PxBounds3& bounds) const;
+	};
+}
+
+#endif // _FRUSTUM_H_
@@ -0,0 +1,103 @@
+/*-------------------------------------------------------------------------\
+| File: GLCORE.H															|
+| Desc: Provides declarations for the OpenGL 1.5 - 3.3 entry points and		|
+|		tokens not exported by opengl32.lib, loaded at runtime.				|
+| Definition File: GLCORE.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _GL_CORE_H_
+#define _GL_CORE_H_
+
+#include <Windows.h>
+#include "GL/glut.h"
+#include <cstddef>
+
+namespace GameFramework
+{
+	namespace GLCore
+	{
+		typedef char GLchar;
+		typedef ptrdiff_t GLintptr;
+		typedef ptrdiff_t GLsizeiptr;
+		typedef unsigned long long GLuint64;
+		typedef struct __GLsync* GLsync;
+
+		// Buffer objects
+		static const GLenum ARRAY_BUFFER			= 0x8892;
+		static const GLenum ELEMENT_ARRAY_BUFFER	= 0x8893;
+		static const GLenum PIXEL_PACK_BUFFER		= 0x88EB;
+		static const GLenum UNIFORM_BUFFER			= 0x8A11;
+		static const GLenum STREAM_READ				= 0x88E1;
+		static const GLenum STATIC_DRAW				= 0x88E4;
+		static const GLenum DYNAMIC_DRAW			= 0x88E8;
+		static const GLbitfield MAP_READ_BIT		= 0x0001;
+
+		// Shaders
+		static const GLenum FRAGMENT_SHADER			= 0x8B30;
+		static const GLenum VERTEX_SHADER			= 0x8B31;
+		static const GLenum COMPILE_STATUS			= 0x8B81;
+		static const GLenum LINK_STATUS				= 0x8B82;
+		static const GLenum INFO_LOG_LENGTH			= 0x8B84;
+		static const GLuint INVALID_INDEX			= 0xFFFFFFFFu;
+
+		// Sync objects
+		static const GLenum SYNC_GPU_COMMANDS_COMPLETE	= 0x9117;
+		static const GLenum ALREADY_SIGNALED			= 0x911A;
+		static const GLenum CONDITION_SATISFIED			= 0x911C;
+		static const GLbitfield SYNC_FLUSH_COMMANDS_BIT	= 0x0001;
+
+		// Pixel formats
+		static const GLenum BGRA					= 0x80E1;
+
+		// Buffer objects
+		extern void (WINAPI *GenBuffers)(GLsizei n, GLuint* buffers);
+		extern void (WINAPI *DeleteBuffers)(GLsizei n, const GLuint* buffers);
+		extern void (WINAPI *BindBuffer)(GLenum target, GLuint buffer);
+		extern void (WINAPI *BindBufferBase)(GLenum target, GLuint index, GLuint buffer);
+		extern void (WINAPI *BufferData)(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+		extern void (WINAPI *BufferSubData)(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+		extern void* (WINAPI *MapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+		extern GLboolean (WINAPI *UnmapBuffer)(GLenum target);
+
+		// Vertex arrays
+		extern void (WINAPI *GenVertexArrays)(GLsizei n, GLuint* arrays);
+		extern void (WINAPI *DeleteVertexArrays)(GLsizei n, const GLuint* arrays);
+		extern void (WINAPI *BindVertexArray)(GLuint array);
+		extern void (WINAPI *VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+		extern void (WINAPI *EnableVertexAttribArray)(GLuint index);
+
+		// Shaders and programs
+		extern GLuint (WINAPI *CreateShader)(GLenum type);
+		extern void (WINAPI *DeleteShader)(GLuint shader);
+		extern void (WINAPI *ShaderSource)(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+		extern void (WINAPI *CompileShader)(GLuint shader);
+		extern void (WINAPI *GetShaderiv)(GLuint shader, GLenum pname, GLint* params);
+		extern void (WINAPI *GetShaderInfoLog)(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+		extern GLuint (WINAPI *CreateProgram)();
+		extern void (WINAPI *DeleteProgram)(GLuint program);
+		extern void (WINAPI *AttachShader)(GLuint program, GLuint shader);
+		extern void (WINAPI *LinkProgram)(GLuint program);
+		extern void (WINAPI *GetProgramiv)(GLuint program, GLenum pname, GLint* params);
+		extern void (WINAPI *GetProgramInfoLog)(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+		extern void (WINAPI *UseProgram)(GLuint program);
+		extern GLint (WINAPI *GetUniformLocation)(GLuint program, const GLchar* name);
+		extern GLuint (WINAPI *GetUniformBlockIndex)(GLuint program, const GLchar* uniformBlockName);
+		extern void (WINAPI *UniformBlockBinding)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
+		extern void (WINAPI *Uniform3fv)(GLint location, GLsizei count, const GLfloat* value);
+		extern void (WINAPI *UniformMatrix3fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+		extern void (WINAPI *UniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+
+		// Sync objects
+		extern GLsync (WINAPI *FenceSync)(GLenum condition, GLbitfield flags);
+		extern void (WINAPI *DeleteSync)(GLsync sync);
+		extern GLenum (WINAPI *ClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
+
+		/* Loads the entry points from the current context. Returns false if the context is older than 3.3, or any are missing. */
+		bool Load();
+
+		/* True once Load has succeeded */
+		bool IsLoaded();
+	}
+}
+
+#endif // _GL_CORE_H_
@@ -9,7 +9,11 @@
 #define GAME_H
 
 #include <string>
-#include <time.h>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
 #include "camera.h"
 #include "gameState.h"
 #include "Physics.h"
@@ -18,13 +22,48 @@
 #include "uncopyable.h"
 #include "log.h"
 #include "timer.h"
-#include "BASS\bass.h"
+#include "frameClock.h"
+#include "frameProfiler.h"
+#include "meshLOD.h"
+#include "coreRenderer.h"
+#include "frameCapture.h"
+#include "startupTrace.h"
+#include "assetArchive.h"
+#include "frameSnapshot.h"
+#include "tripleBuffer.h"
+#include "offscreenContext.h"
+#include "audio.h"
+#include "audioLatency.h"
 
 #define FPS 60.f
-#define RENDER_DETAIL 15
+
+// Most fixed physics steps taken per frame, time beyond this is dropped rather than caught up
+#define PHYSICS_MAX_STEPS 4
+
+// Render benchmark report file
+#define RENDER_BENCH_LOG "renderBench.txt"
 
 namespace GameFramework
 {
+	enum class InputType
+	{
+		MouseButton,
+		MouseMove,
+		KeyboardDown,
+		KeyboardUp,
+		SpecKeyboardDown,
+		SpecKeyboardUp
+	};
+
+	/* A GLUT input callback, recorded so it can be handled on the simulation thread */
+	struct InputEvent
+	{
+		InputType type;
+		int key;	// Key, or mouse button
+		int state;	// Mouse button state
+		int x, y;
+	};
+
 	class GLUTGame : private Uncopyable
 	{
 	private:
@@ -39,21 +78,119 @@ namespace GameFramework
 		// GLUT Initialization
 		void InitGLUT(int argc, char *argv[]);
 
-		/* BASS Initialization */
-		void InitBASS();
+		/* Offscreen Initialization - GLUT without a window, rendering into a pbuffer */
+		bool InitOffscreen(int argc, char *argv[]);
+
+		/* Rendering offscreen, with no window */
+		bool m_offscreen;
+		OffscreenContext m_offscreenContext;
+
+		/* Audio Initialization - starts the audio thread on the selected backend */
+		void InitAudio();
+
+		/* Backend sounds play through. Offscreen runs use the null backend unless one is set explicitly. */
+		AudioBackendType m_audioBackend;
+		bool m_audioBackendSet;
+		AudioConfig m_audioConfig;
 
 		/* The game's clear color */
 		static Vec3 ClearColor;
 
 		/* Used For timers */
-		clock_t lastElapsedTime;
-		clock_t newElapsedTime;
+		FrameClock m_frameClock;
+
+		/* Limits the rate Idle is called at */
+		FramePacer m_framePacer;
+		bool m_vsync;
+
+		/* Draw the profiler's frame time graph over each frame */
+		std::atomic<bool> m_showProfileGraph;
+
+		/* Threaded mode - game logic and physics run on a simulation thread, while the GLUT thread (which owns the GL context) only renders */
+		bool m_threaded;
+		std::thread m_simulationThread;
+		std::atomic<bool> m_simulationRunning;
+		std::atomic<bool> m_exitRequested;
+		std::atomic<int> m_exitStatus;
+		FramePacer m_simulationPacer;
+		FrameProfiler m_simulationProfiler;
+
+		/* Input received on the GLUT thread, waiting for the simulation thread */
+		std::mutex m_inputMutex;
+		std::vector<InputEvent> m_inputQueue;
+		std::vector<InputEvent> m_inputDrain;
+
+		/* Snapshots from the simulation, newest complete one drawn by Render */
+		TripleBuffer<FrameSnapshot> m_snapshots;
+
+		/* Runs Tick at the simulation rate until stopped */
+		void SimulationLoop();
+
+		/* Advances the game one step (logic, then physics) and publishes a snapshot */
+		void Tick();
+
+		/* Captures and publishes a snapshot, without advancing the game */
+		void PublishSnapshot();
+
+		/* Queues input in threaded mode, otherwise handles it straight away */
+		void HandleInput(const InputEvent& e);
+		void DispatchInput(const InputEvent& e);
+		void DrainInput();
+
+		bool OnSimulationThread() const;
+
+		/* Backend RenderShapes draws with, and the core profile renderer behind RenderBackend::Core */
+		RenderBackend m_renderBackend;
+		CoreRenderer m_coreRenderer;
+
+		/* Brings up the selected render backend, falling back to fixed function if it is unavailable */
+		void InitRenderer();
+
+		/* Frame recording. Requests may come from the simulation thread, so they are applied on the GL thread by UpdateCapture. */
+		FrameCapture m_capture;
+		std::atomic<bool> m_captureWanted;
+		std::atomic<int> m_captureFormat;
+
+		/* Starts or stops recording as requested, then captures the frame about to be presented */
+		void UpdateCapture();
+
+		/* Set by MarkStartupComplete, the next presented frame is the first frame of the startup trace */
+		std::atomic<bool> m_startupComplete;
+
+		/* Renders a unit cube (half extents of 1) from a prebuilt vertex array */
+		void RenderCube(bool textured);
+
+		/* Precomputed sphere tessellations, picked per draw by size on screen */
+		SphereLODSet m_sphereLODs;
+
+		/* Simplified stand ins for convex meshes, drawn when the mesh is small on screen */
+		std::map<const physx::PxConvexMesh*, physx::PxConvexMesh*> m_simplifiedHulls;
+
+		/* View frustum of the camera, as of the last UpdateFrustum */
+		Frustum m_frustum;
+
+		/* World bounds of static actors, which never move. Keyed by pointer, so cleared whenever the scene gains actors. */
+		std::map<const physx::PxRigidActor*, physx::PxBounds3> m_staticBounds;
+		unsigned int m_boundsGeneration;
+
+		/* Wall time fed into the physics accumulator */
+		FrameClock m_physicsClock;
+
+		/* Previous and current simulated pose of a dynamic actor */
+		struct PoseHistory
+		{
+			Transform previous, current;
+		};
+
+		/* Draw dynamic actors blended between their last two simulated poses */
+		bool m_interpolate;
+		std::map<const physx::PxRigidActor*, PoseHistory> m_poseHistory;
 
-		/* Renders a textured cube */
-		void RenderTexturedCube(GLint size);
+		/* Shifts each dynamic actor's current pose to previous, and records the new one */
+		void RecordPoses();
 
-		/* Milliseconds since the last frame */
-		Fl32 m_milliSecondsSinceLastFrame;
+		/* Renders a convex mesh as triangles */
+		void RenderConvexMesh(const physx::PxConvexMesh* mesh);
 
 		/* Calculates Delta Time */
 		void CalculateDeltaTime();
@@ -66,15 +203,61 @@ namespace GameFramework
 		Physics::Scene* m_scene;
 		Fl32 m_pxTimeStep;
 
-		// Renders the given geometric object
-		void RenderGeometry(physx::PxGeometryHolder h, bool textured = false);
+		/* Steps the simulation once per Tick, after Idle. Defaults to StepPhysics. */
+		virtual void Simulate();
+
+		/* Fills snapshot with what Render needs to draw the current game state. Runs on the simulation thread in threaded mode. */
+		virtual void CaptureSnapshot(FrameSnapshot& snapshot);
+
+		/* Newest snapshot published by the simulation, for Render to draw from */
+		const FrameSnapshot& Snapshot() const;
+
+		/* Clears the frame to the snapshot's clear color */
+		void ClearFrame();
+
+		/* Draws the snapshot's shapes */
+		void RenderShapes(const FrameSnapshot& snapshot);
+
+		/* Profiler for input, logic and physics - the render profiler, unless threaded */
+		FrameProfiler& SimulationProfiler();
+
+		/* Exits the game with the given process exit status (non-zero for a failure) - from the simulation thread, the GLUT
+		   thread is asked to exit instead */
+		void RequestExit(int status = 0);
+
+		/* Advances physics by the wall time since the last call, in fixed steps of m_pxTimeStep. Returns the steps taken. */
+		int StepPhysics();
+
+		/* Call instead of StepPhysics while the simulation isn't running, so the time isn't owed to it once it is */
+		void SkipPhysics();
+
+		/* Places a shape of actor for drawing. With interpolation on, a dynamic actor's last two step poses go in the snapshot,
+		   and the renderer blends them by its own clock. */
+		void SetShapePose(ShapeDraw& draw, const physx::PxRigidActor* actor, const Transform& localPose) const;
+
+		/* Renders the given geometric object. pixelsPerUnit is how many pixels one unit covers at the shape's depth, for
+		   picking levels of detail. */
+		void RenderGeometry(physx::PxGeometryHolder h, Fl32 pixelsPerUnit, bool textured = false);
+
+		/* Draws simplified in place of mesh while mesh covers fewer than HULL_LOD_PIXELS (e.g. cooked with a low PxConvexMeshDesc::vertexLimit). Pass NULL to clear. */
+		void SetSimplifiedHull(const physx::PxConvexMesh* mesh, physx::PxConvexMesh* simplified);
 
 		Camera camera;
 
-		/* Current Delta Time */
+		/* Rebuilds the culling frustum from the camera, call after moving it */
+		void UpdateFrustum();
+
+		/* Tests an actor's world bounds against the camera frustum */
+		bool IsVisible(const physx::PxRigidActor* actor);
+
+		/* Discards cached static actor bounds. Done by IsVisible when actors are added to the scene (the table is rebuilt, say);
+		   call it directly if a static actor is moved. */
+		void ClearBoundsCache();
+
+		/* Current Delta Time, in seconds */
 		Fl32 deltaTime;
 		
-		/* Physics Time Step Timer */
+		/* Physics Time Step Timer - simulated time owed, less than m_pxTimeStep after StepPhysics */
 		Fl32 simTimer;
 
 		/* Get window dimensions */
@@ -84,9 +267,33 @@ namespace GameFramework
 		bool m_is2D;
 
 		/* Used for frame rate calculations */
-		int m_fps, m_time, m_timebase, m_frame;
+		std::atomic<int> m_fps;
+		int m_time, m_timebase, m_frame;
 		void CalculateFrameRate();
 
+		/* Per phase frame timings. Input, logic, physics and swap are timed here, derived games time their scene and HUD drawing. */
+		FrameProfiler m_profiler;
+
+		/* Writes the profiler's percentile report to the profile and engine logs */
+		void ReportProfile();
+
+		/* Toggles the frame time graph overlay */
+		void ToggleProfileGraph();
+
+		/* Call from Render once the frame being drawn is the first worth showing (e.g. the menu, with its image loaded).
+		   Presenting it ends the startup trace. */
+		void MarkStartupComplete();
+
+		/* Presents a finished frame (swaps buffers, or waits for the offscreen frame to complete) */
+		void PresentFrame();
+
+		/* Requests a redraw, ignored when rendering offscreen */
+		void PostRedisplay();
+
+		/* Render benchmark scenes - override to expose game states to RunRenderBenchmark */
+		virtual int BenchmarkSceneCount();
+		virtual std::string SetBenchmarkScene(int scene);
+
 	public:
 		// Construction/Destruction
 		GLUTGame(std::string title, int windowWidth, int windowHeight);
@@ -95,7 +302,44 @@ namespace GameFramework
 		/* Updates the games projection matrix */
 		static void UpdatePerspective(const Fl32& FOV);
 
-		/* Set the game's clear color */
+		/* Aspect ratio used by the projection matrix */
+		static Fl32 AspectRatio();
+
+		/* Frame rate the game loop is limited to, 0 for unlimited (defaults to FPS) */
+		void SetTargetFrameRate(Fl32 framesPerSecond);
+		Fl32 TargetFrameRate() const;
+
+		/* Runs game logic and physics on their own thread, so rendering never waits on them. Call before Run. */
+		void SetThreadedSimulation(bool enabled);
+
+		/* Rate the simulation thread ticks at, 0 for unlimited (defaults to FPS) */
+		void SetSimulationRate(Fl32 ticksPerSecond);
+
+		/* Toggles drawing dynamic actors interpolated between physics steps (costs one step of latency) */
+		void SetRenderInterpolation(bool enabled);
+		bool RenderInterpolation() const;
+
+		/* Selects the renderer for the board's shapes (defaults to FixedFunction). Call before Run. */
+		void SetRenderBackend(RenderBackend backend);
+
+		/* Backend in use - FixedFunction if Core was requested but the context doesn't support it */
+		RenderBackend GetRenderBackend() const;
+
+		/* Selects what plays the game's sounds (defaults to BASS). Call before Run. */
+		void SetAudioBackend(AudioBackendType backend);
+
+		/* Sets the audio thread's period and the backend's buffering (defaults to AudioConfig's). Call before Run. */
+		void SetAudioConfig(const AudioConfig& config);
+
+		/* Records each presented frame into a new capture_<date>_<time> directory, until disabled. Offscreen, no frames are
+		   dropped if the writer falls behind - rendering waits for it instead. */
+		void SetCapture(bool enabled, CaptureFormat format = CaptureFormat::PNG);
+		bool IsCapturing() const;
+
+		/* Requests vsync through WGL_EXT_swap_control. Call before Run, or once the window exists. */
+		void SetVSync(bool enabled);
+
+		/* Set the game's clear color (applied by ClearFrame) */
 		void SetClearColor(const Vec3& color);
 
 		/* Get the game's clear color */
@@ -103,6 +347,13 @@ namespace GameFramework
 
 		void Run(int argc, char *argv[]); // Enters the main loop
 
+		/* Renders frames of each benchmark scene offscreen (no window) and reports the frame cost */
+		void RunRenderBenchmark(int argc, char *argv[], int frames);
+
+		/* Starts up offscreen and renders until the first frame is complete, writing the time to it to STARTUP_PROBE_LOG.
+		   Run as a separate process by StartupBenchmark. */
+		void RunStartupProbe(int argc, char *argv[]);
+
 		virtual void Init();
 
 		// Instance Callback Functions
@@ -0,0 +1,56 @@
+/*-------------------------------------------------------------------------\
+| File: GLYPHATLAS.H														|
+| Desc: Provides declarations for a texture atlas of GLUT bitmap glyphs		|
+| Definition File: GLYPHATLAS.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _GLYPH_ATLAS_H_
+#define _GLYPH_ATLAS_H_
+
+#include "globals.h"
+#include "GL/glut.h"
+#include <vector>
+
+// Printable ASCII range held in the atlas
+#define GLYPH_FIRST		32
+#define GLYPH_LAST		126
+#define GLYPH_COUNT		(GLYPH_LAST - GLYPH_FIRST + 1)
+
+// Atlas layout (cell size and grid must give power of two texture dimensions)
+#define GLYPH_CELL		32
+#define GLYPH_COLUMNS	16
+#define GLYPH_ROWS		8
+#define GLYPH_PADDING	4
+
+namespace GameFramework
+{
+	/* A single vertex of a glyph quad, laid out for glInterleavedArrays(GL_T2F_V3F) */
+	struct GlyphVertex
+	{
+		GLfloat s, t;
+		GLfloat x, y, z;
+	};
+
+	class GlyphAtlas
+	{
+	private:
+		unsigned int m_texID;
+		void* m_font;
+		int m_descent;
+		int m_advance[GLYPH_COUNT];
+	public:
+		GlyphAtlas();
+		~GlyphAtlas();
+
+		/* Draws every glyph of the font into the back buffer and copies it into a texture.
+		   Clears the back buffer, so call before the first frame is drawn. */
+		void Build(void* font, int descent);
+
+		/* Appends quads for the given characters to a vertex run, returns the pen position after the last character */
+		Fl32 Append(std::vector<GlyphVertex>& run, const char* text, int length, Fl32 penX, Fl32 penY) const;
+
+		unsigned int TextureID() const;
+	};
+}
+
+#endif // _GLYPH_ATLAS_H_
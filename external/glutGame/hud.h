@@ -3,7 +3,7 @@
 
 #include "uncopyable.h"
 #include "globals.h"
-#include "glutGame.h"
+#include "glyphAtlas.h"
 #include <GL\glut.h>
 #include <string>
 #include <vector>
@@ -16,6 +16,15 @@ namespace GameFramework
 		smallFont = (int)GLUT_BITMAP_HELVETICA_18
 	};
 
+	/* Refers to an item added to a HUD, valid until the HUD is next cleared */
+	struct HUDHandle
+	{
+		HUDHandle() : index(-1), generation(0) { }
+		HUDHandle(int Index, unsigned int Generation) : index(Index), generation(Generation) { }
+		int index;
+		unsigned int generation;
+	};
+
 	class HUDItem
 	{
 	private:
@@ -26,27 +35,69 @@ namespace GameFramework
 		HUDFont m_font;
 		int m_data;
 		bool m_dataItem;
+
+		/* Cached glyph quads, rebuilt only when the item is dirty */
+		std::vector<GlyphVertex> m_run;
+		bool m_dirty;
 	public:
 		friend class HUD;
 
 		virtual ~HUDItem();
 	};
 
+	/* Copy of a HUD's items, passed from the HUD the game updates to the one that draws */
+	struct HUDSnapshot
+	{
+		HUDSnapshot() : layout(0), color(0.f) { }
+
+		/* Layout the items were copied at, 0 matches no HUD */
+		unsigned int layout;
+		Vec3 color;
+		std::vector<HUDItem> items;
+	};
+
 	class HUD : private Uncopyable
 	{
 	private:
 		Vec3 textColor;
 
 		std::vector<HUDItem> m_items;
+
+		/* Incremented by Clear, so handles to removed items are rejected */
+		unsigned int m_generation;
+
+		/* Incremented whenever items are added or removed, or the color changes */
+		unsigned int m_layout;
+
+		/* Glyph atlases, one per HUDFont */
+		GlyphAtlas m_largeAtlas, m_smallAtlas;
+
+		/* Window dimensions the cached runs were laid out for */
+		int m_width, m_height;
+
+		const GlyphAtlas& Atlas(HUDFont font) const;
+		void BuildRun(HUDItem& item);
 	public:
 		HUD();
 		virtual ~HUD();
 
+		/* Builds the glyph atlases, call once the GL context exists and before the first frame */
+		void Init(int width, int height);
+
+		/* Lays the HUD out for a new window size */
+		void Resize(int width, int height);
+
 		void SetRenderColor(Vec3 color);
 		void Render(Fl32 FOV);
-		void AddItem(std::string text, Vec2 pos, HUDFont font, bool dataItem = false, int initialData = 0);
-		bool UpdateItem(std::string text, int newData);
+		HUDHandle AddItem(std::string text, Vec2 pos, HUDFont font, bool dataItem = false, int initialData = 0);
+		bool UpdateItem(const HUDHandle& item, int newData);
 		void Clear();
+
+		/* Copies the items into snapshot - only the data values, if the layout is unchanged since it was last captured */
+		void Capture(HUDSnapshot& snapshot) const;
+
+		/* Takes items from a snapshot, rebuilding glyph runs only for those that changed */
+		void Apply(const HUDSnapshot& snapshot);
 	};
 }
 #endif // _HUD_H_
@@ -9,6 +9,7 @@
 
 #include "globals.h"
 #include "gl/glut.h"
+#include "textureManager.h"
 #include <string>
 #include <array>
 
@@ -17,19 +18,32 @@ namespace GameFramework
 	class Image
 	{
 	private:
-		unsigned int m_texID;
+		TextureHandle m_texture;
 		std::string m_fileName;
 
 		void cpy(const Image& param);
 
 	public:
 		Image();
-		Image(const std::string& fileName);
+		/* Loads fileName (relative to img\), on the image decoding threads if background is set */
+		Image(const std::string& fileName, bool background = false);
 		Image(const Image& param);
 		Image& operator=(const Image& param);
 		~Image();
 		
+		/* Draws the image over the viewport - nothing is drawn until it has loaded */
 		void Render();
+
+		bool IsLoaded() const;
+
+		/* True while the image holds its texture, loaded or still loading */
+		bool IsAcquired() const;
+
+		/* Video memory the image's texture takes, 0 until it has loaded */
+		unsigned int Bytes() const;
+
+		/* Drops the image's texture, which is freed once no other image shares it */
+		void Release();
 	};
 }
 
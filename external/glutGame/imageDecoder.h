@@ -0,0 +1,69 @@
+/*-------------------------------------------------------------------------\
+| File: IMAGEDECODER.H														|
+| Desc: Provides declarations for a pool of worker threads decoding			|
+|		images into CPU side pixel buffers, ready for upload on the GL		|
+|		thread.																|
+| Definition File: IMAGEDECODER.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _IMAGE_DECODER_H_
+#define _IMAGE_DECODER_H_
+
+#include "uncopyable.h"
+#include "textureCache.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace GameFramework
+{
+	/* An image decoded by SOIL_load_image, or its mip chain read from the texture cache. The pixels are owned by whoever
+	   takes it from the decoder, and freed with Free. */
+	struct DecodedImage
+	{
+		DecodedImage() : pixels(NULL), width(0), height(0), channels(0) { }
+
+		std::string path;
+		unsigned char* pixels; // NULL if decoding failed, or the image was cached
+		int width, height, channels;
+		CachedTexture cached;
+
+		void Free();
+	};
+
+	class ImageDecoder : private Uncopyable
+	{
+	private:
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_jobQueued;
+		std::deque<std::string> m_jobs;
+		std::deque<DecodedImage> m_decoded;
+		bool m_stopping;
+
+		void WorkerLoop();
+	public:
+		ImageDecoder();
+		~ImageDecoder();
+
+		/* Starts the workers, if they aren't running. 0 threads uses one less than the number of cores (at least one). */
+		void Start(unsigned int threads = 0);
+
+		/* Abandons queued jobs, waits for the workers and frees anything decoded but not taken */
+		void Stop();
+
+		bool IsRunning() const;
+
+		/* Queues an image (relative to img\) for decoding, in request order. Images with an up to date texture cache entry
+		   are read from the cache instead. */
+		void Queue(const std::string& dataPath);
+
+		/* Takes the next decoded image, returning false if none is finished */
+		bool Poll(DecodedImage& image);
+	};
+}
+
+#endif // _IMAGE_DECODER_H_
@@ -11,10 +11,32 @@
 #include "SOIL.h"
 #include "log.h"
 #include "GL/glut.h"
+#include "textureCache.h"
+#include "assetArchive.h"
+
+// SOIL flags every texture is created with
+#define TEXTURE_FLAGS (SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT)
 
 namespace GameFramework
 {
+	/* Full path of an image in the img directory */
+	std::string ImagePath(const std::string& dataPath);
+
+	/* Decodes an image into pixels for SOIL_create_OGL_texture, from the asset archive if it holds the image, otherwise from
+	   its loose file. Free the result with SOIL_free_image_data; NULL on failure. */
+	unsigned char* DecodeImage(const std::string& dataPath, int* width, int* height, int* channels);
+
+	/* Uploads an image from the texture cache, or decodes, uploads and caches it. Returns its texture (0 on failure). */
 	unsigned int LoadTexture(const std::string& dataPath);
+
+	/* Uploads pixels decoded by SOIL_load_image from dataPath, and caches the result. Returns 0 on failure. */
+	unsigned int UploadTexture(const unsigned char* pixels, int width, int height, int channels, const std::string& dataPath);
+
+	/* Uploads a mip chain read from the texture cache. Returns 0 on failure. */
+	unsigned int UploadTexture(const CachedTexture& cached);
+
+	/* Video memory a texture's mip chain takes, in bytes (estimated at 4 bytes a texel when uncompressed). Call on the GL thread. */
+	unsigned int TextureMemory(unsigned int textureID);
 }
 
-#endif // _LOAD_IMAGE_H_
\ No newline at end of file
+#endif // _LOAD_IMAGE_H_
@@ -0,0 +1,69 @@
+/*-------------------------------------------------------------------------\
+| File: MESHLOD.H															|
+| Desc: Provides declarations for precomputed sphere meshes at several		|
+|		levels of detail, chosen by their size on screen.					|
+| Definition File: MESHLOD.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _MESH_LOD_H_
+#define _MESH_LOD_H_
+
+#include "globals.h"
+#include "GL/glut.h"
+#include <vector>
+
+#define SPHERE_LOD_COUNT 4
+
+// Convex meshes covering fewer pixels (radius) than this draw their simplified hull, if one is set
+#define HULL_LOD_PIXELS 12.f
+
+namespace GameFramework
+{
+	/* A single vertex of a lit mesh, laid out for glInterleavedArrays(GL_N3F_V3F) */
+	struct MeshVertex
+	{
+		GLfloat nx, ny, nz;
+		GLfloat x, y, z;
+	};
+
+	/* Unit sphere, tessellated once and drawn from vertex arrays */
+	class SphereMesh
+	{
+	private:
+		std::vector<MeshVertex> m_vertices;
+		std::vector<GLushort> m_indices;
+	public:
+		SphereMesh();
+		~SphereMesh();
+
+		void Build(int slices, int stacks);
+		void Render() const;
+
+		int TriangleCount() const;
+
+		const std::vector<MeshVertex>& Vertices() const;
+		const std::vector<GLushort>& Indices() const;
+	};
+
+	/* Sphere meshes from coarse to fine */
+	class SphereLODSet
+	{
+	private:
+		SphereMesh m_lods[SPHERE_LOD_COUNT];
+	public:
+		SphereLODSet();
+		~SphereLODSet();
+
+		void Build();
+
+		/* Picks the mesh for a sphere covering pixelRadius pixels on screen */
+		const SphereMesh& Select(Fl32 pixelRadius) const;
+
+		/* Index of the level Select picks, from 0 (coarsest) to SPHERE_LOD_COUNT - 1 */
+		int SelectIndex(Fl32 pixelRadius) const;
+
+		const SphereMesh& Level(int index) const;
+	};
+}
+
+#endif // _MESH_LOD_H_
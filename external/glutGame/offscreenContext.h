@@ -0,0 +1,52 @@
+/*-------------------------------------------------------------------------\
+| File: OFFSCREENCONTEXT.H													|
+| Desc: Provides declarations for a windowless OpenGL context, rendering	|
+|		into a pbuffer (works with Mesa's software rasterizer).				|
+| Definition File: OFFSCREENCONTEXT.CPP										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _OFFSCREEN_CONTEXT_H_
+#define _OFFSCREEN_CONTEXT_H_
+
+#include <Windows.h>
+#include "uncopyable.h"
+
+namespace GameFramework
+{
+	DECLARE_HANDLE(HPBUFFERARB);
+
+	class OffscreenContext : private Uncopyable
+	{
+	private:
+		// Hidden window and context, only needed to query the pbuffer extension
+		HWND m_dummyWindow;
+		HDC m_dummyDC;
+		HGLRC m_dummyRC;
+
+		HPBUFFERARB m_pbuffer;
+		HDC m_pbufferDC;
+		HGLRC m_pbufferRC;
+
+		// Pbuffer teardown entry points, queried while a context is current
+		PROC m_releasePbufferDC;
+		PROC m_destroyPbuffer;
+
+		int m_width, m_height;
+
+		bool CreateDummy();
+		void ReleaseDummy();
+	public:
+		OffscreenContext();
+		~OffscreenContext();
+
+		/* Creates a pbuffer of the given size and makes its context current. Returns false on failure. */
+		bool Create(int width, int height);
+		void Release();
+
+		bool IsValid() const;
+		int Width() const;
+		int Height() const;
+	};
+}
+
+#endif // _OFFSCREEN_CONTEXT_H_
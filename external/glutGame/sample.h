@@ -1,36 +1,36 @@
 /*
 	File: SAMPLE.H
 	Author: Henri Keeble
-	Desc: Declares a simple sample class using BASS.
+	Desc: Declares a simple sample class, played through the audio thread.
 */
 #ifndef _SAMPLE_H_
 #define _SAMPLE_H_
 
-#include "BASS\bass.h"
 #include <string>
 #include "log.h"
+#include "audio.h"
 
 namespace GameFramework
 {
+	/* Play and Stop only queue a request, so they are safe to call from any thread. Copies share the sound. Each Play
+	   starts a new voice, so overlapping hits all sound; once all voices are busy the oldest is cut off. */
 	class Sample
 	{
 	private:
-		HSAMPLE sound;
-		HCHANNEL channel;
+		SoundID sound;
 	protected:
-		HSAMPLE GetSample() const;
-		HCHANNEL GetChannel() const;
+		SoundID ID() const;
 	public:
 		Sample();
-		Sample(const char* filename);
+		Sample(const char* filename, unsigned int voices = AUDIO_SAMPLE_VOICES);
 		Sample(const Sample& param);
 		Sample& operator=(const Sample& param);
 		~Sample();
 
 		virtual void Play();
 		virtual void Stop();
-		void Load(const char* filename);
+		void Load(const char* filename, unsigned int voices = AUDIO_SAMPLE_VOICES);
 	};
 }
 
-#endif // _SAMPLE_H_
\ No newline at end of file
+#endif // _SAMPLE_H_
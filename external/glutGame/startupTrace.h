@@ -0,0 +1,88 @@
+/*-------------------------------------------------------------------------\
+| File: STARTUPTRACE.H														|
+| Desc: Provides declarations for timing startup phases, a report of them	|
+|		in Chrome trace event format, and a time to first frame				|
+|		benchmark run across fresh processes.								|
+| Definition File: STARTUPTRACE.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _STARTUP_TRACE_H_
+#define _STARTUP_TRACE_H_
+
+#include "frameClock.h"
+#include "uncopyable.h"
+#include <string>
+#include <vector>
+#include <mutex>
+
+// Startup phase report (load in chrome://tracing), written once the first frame is presented
+#define STARTUP_TRACE_LOG "startupTrace.json"
+
+// Time to first frame of a single probe run, in milliseconds, read back by the benchmark
+#define STARTUP_PROBE_LOG "startupProbe.txt"
+
+// Benchmark report, and the time to first frame it compares against (written by the first run if missing)
+#define STARTUP_BENCH_LOG "startupBench.txt"
+#define STARTUP_BASELINE "startupBaseline.txt"
+
+// Median time to first frame above baseline * this fails the benchmark
+#define STARTUP_REGRESSION_THRESHOLD 1.25
+
+// Longest a probe run may take, in milliseconds
+#define STARTUP_PROBE_TIMEOUT 60000
+
+namespace GameFramework
+{
+	/* A timed phase, in milliseconds since the process was created */
+	struct TraceEvent
+	{
+		std::string name;
+		double start, duration;
+		unsigned long thread;
+	};
+
+	/* Records timed phases until the first frame is presented (and the report written), then ignores them */
+	class StartupTrace
+	{
+	private:
+		static std::mutex m_mutex;
+		static std::vector<TraceEvent> m_events;
+		static double m_firstFrame;
+		static bool m_written;
+	public:
+		/* Milliseconds since the process was created */
+		static double Elapsed();
+
+		static void Record(const std::string& name, double start, double end);
+
+		/* Records the time to first frame and writes the report */
+		static void MarkFirstFrame();
+
+		/* Time to first frame in milliseconds, negative if it hasn't been marked */
+		static double FirstFrame();
+
+		/* Writes the phases recorded so far to STARTUP_TRACE_LOG, and stops recording. Only the first call writes. */
+		static void Write();
+	};
+
+	/* Records its own lifetime as a startup phase */
+	class TraceScope : private Uncopyable
+	{
+	private:
+		std::string m_name;
+		double m_start;
+	public:
+		TraceScope(const std::string& name);
+		~TraceScope();
+	};
+
+	/* Launches the game repeatedly in probe mode and compares the median time to first frame against the baseline */
+	class StartupBenchmark
+	{
+	public:
+		/* Runs this executable with probeArgs, runs times. Returns 0 on success, 1 on a regression, 2 if a probe failed. */
+		static int Run(const std::string& probeArgs, int runs);
+	};
+}
+
+#endif // _STARTUP_TRACE_H_
@@ -0,0 +1,80 @@
+/*-------------------------------------------------------------------------\
+| File: STATEIMAGES.H														|
+| Desc: Provides declarations for a set of full screen images bound to		|
+|		game states, loaded when their state shows and evicted under a		|
+|		texture memory budget.												|
+| Definition File: STATEIMAGES.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _STATE_IMAGES_H_
+#define _STATE_IMAGES_H_
+
+#include "image.h"
+#include <string>
+#include <vector>
+
+// Default texture memory for state images, enough for a screen and those likely to follow it
+#define STATE_IMAGE_BUDGET (1024 * 1024)
+
+namespace GameFramework
+{
+	/* States are game defined, as in FrameSnapshot. Only images bound to the state showing are kept regardless of the
+	   budget; the rest are evicted, least recently shown first, once loaded images take more than it. */
+	class StateImages
+	{
+	private:
+		struct Screen
+		{
+			std::string fileName;
+			std::vector<int> states;
+			Image image;
+			unsigned int bytes;			  // Size when last loaded, 0 if it never has been
+			unsigned long long lastShown; // Show call it was last shown by, 0 if it never has been
+		};
+
+		std::vector<Screen> m_screens;
+
+		/* Likely transitions, as (from, to) */
+		std::vector<std::pair<int, int> > m_transitions;
+
+		unsigned int m_budget;
+		unsigned long long m_showCount;
+
+		bool IsBound(const Screen& screen, int state) const;
+
+		/* Memory a screen's image takes, or will once loaded if its size is known from an earlier load */
+		unsigned int Committed(const Screen& screen) const;
+
+		/* True while an image that has never loaded is loading, its size still unknown */
+		bool IsLoadingUnknown() const;
+
+		void Prefetch(int state);
+		void Evict(int state);
+	public:
+		StateImages(unsigned int budget = STATE_IMAGE_BUDGET);
+
+		/* Binds an image (relative to img\) to a state. An image can be bound to several states, and is loaded once. */
+		void Bind(int state, const std::string& fileName);
+
+		/* Marks a likely transition, so to's images are prefetched while from shows (if they fit the budget) */
+		void Link(int from, int to);
+
+		void SetBudget(unsigned int bytes);
+		unsigned int Budget() const;
+
+		/* Starts loading state's images in the background, prefetches those of the states it links to and evicts others
+		   over the budget. Call each frame on the GL thread, before Render. */
+		void Show(int state);
+
+		/* Draws state's images in the order they were bound - nothing is drawn for images still loading */
+		void Render(int state);
+
+		/* True once every image bound to state has loaded */
+		bool IsLoaded(int state) const;
+
+		/* Video memory taken by the images loaded, and by those still loading whose size is known */
+		unsigned int ResidentBytes() const;
+	};
+}
+
+#endif // _STATE_IMAGES_H_
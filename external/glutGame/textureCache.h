@@ -0,0 +1,55 @@
+/*-------------------------------------------------------------------------\
+| File: TEXTURECACHE.H														|
+| Desc: Provides declarations for an on disk cache of compressed mip		|
+|		chains, so textures SOIL has mipmapped and DXT compressed once		|
+|		can be uploaded directly on later runs.								|
+| Definition File: TEXTURECACHE.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+#include <string>
+#include <vector>
+
+// Directory cache entries are written to, alongside img
+#define TEXTURE_CACHE_DIR "texcache"
+
+namespace GameFramework
+{
+	/* One compressed mip level */
+	struct CachedLevel
+	{
+		int width, height;
+		std::vector<unsigned char> data;
+	};
+
+	/* A texture's compressed mip chain, largest level first */
+	struct CachedTexture
+	{
+		CachedTexture() : internalFormat(0) { }
+
+		unsigned int internalFormat;
+		std::vector<CachedLevel> levels;
+
+		bool IsEmpty() const;
+	};
+
+	/* Entries are keyed by image path, the image's modification time and the SOIL flags it was created with - changing
+	   any of them makes the entry stale, and it is rewritten on the next load. */
+	class TextureCache
+	{
+	public:
+		/* Reads dataPath's entry into texture. Returns false if there is no up to date entry. Safe on any thread. */
+		static bool Read(const std::string& dataPath, unsigned int flags, CachedTexture& texture);
+
+		/* Creates a texture from a cached mip chain, returning 0 on failure. Call on the GL thread. */
+		static unsigned int Upload(const CachedTexture& texture);
+
+		/* Reads back a compressed texture's mip chain and stores it as dataPath's entry. Uncompressed textures (no DXT
+		   support) aren't cached. Call on the GL thread. */
+		static bool Write(const std::string& dataPath, unsigned int flags, unsigned int textureID);
+	};
+}
+
+#endif // _TEXTURE_CACHE_H_
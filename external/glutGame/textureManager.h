@@ -0,0 +1,91 @@
+/*-------------------------------------------------------------------------\
+| File: TEXTUREMANAGER.H													|
+| Desc: Provides declarations for a cache of textures keyed by image path,	|
+|		handing out shared handles so each image is loaded once.			|
+| Definition File: TEXTUREMANAGER.CPP										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _TEXTURE_MANAGER_H_
+#define _TEXTURE_MANAGER_H_
+
+#include "uncopyable.h"
+#include "imageDecoder.h"
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <atomic>
+
+// Background loaded textures uploaded per frame, bounding the frame time spent uploading (and compressing) them
+#define TEXTURE_UPLOADS_PER_FRAME 2
+
+namespace GameFramework
+{
+	/* A GL texture loaded from an image, freed once the last handle to it is released */
+	class TextureResource : private Uncopyable
+	{
+	private:
+		std::string m_path;
+		std::atomic<unsigned int> m_id;
+		std::atomic<unsigned int> m_bytes;
+		std::atomic<bool> m_loaded;
+
+		/* Completes a background load */
+		void SetLoaded(unsigned int id);
+
+		friend class TextureManager;
+	public:
+		/* A texture still loading in the background */
+		TextureResource(const std::string& path);
+
+		/* A texture already loaded (id is 0 if that failed). Call on the GL thread. */
+		TextureResource(const std::string& path, unsigned int id);
+		~TextureResource();
+
+		/* GL texture name, 0 while loading or if the image failed to load */
+		unsigned int ID() const;
+		const std::string& Path() const;
+
+		/* Video memory the texture takes, 0 while loading or if the image failed to load */
+		unsigned int Bytes() const;
+
+		/* True once loading has finished, successfully or not */
+		bool IsLoaded() const;
+	};
+
+	typedef std::shared_ptr<TextureResource> TextureHandle;
+
+	/* Resolves each image path (relative to img\) to a single texture, shared by every handle to it */
+	class TextureManager
+	{
+	private:
+		static std::mutex m_mutex;
+		static std::map<std::string, std::weak_ptr<TextureResource> > m_textures;
+
+		/* Textures whose last handle went away, waiting for the GL thread to delete them */
+		static std::vector<unsigned int> m_released;
+
+		/* Decodes images for AcquireAsync on worker threads */
+		static ImageDecoder m_decoder;
+
+		friend class TextureResource;
+	public:
+		/* Returns the texture for dataPath, loading it if no handle to it is alive. Call on the GL thread. If the path is
+		   already loading in the background, that texture is returned, still loading. */
+		static TextureHandle Acquire(const std::string& dataPath);
+
+		/* Returns the texture for dataPath straight away, decoding it on a worker thread if no handle to it is alive. It is
+		   uploaded by a later Update. Can be called from any thread. */
+		static TextureHandle AcquireAsync(const std::string& dataPath);
+
+		/* Deletes textures released since the last call and uploads up to maxUploads decoded images (0 for all of them).
+		   Handles may be dropped on any thread, so this runs each frame on the GL thread. */
+		static void Update(unsigned int maxUploads = TEXTURE_UPLOADS_PER_FRAME);
+
+		/* Stops the decoding threads, abandoning any loads in progress. Call before exiting. */
+		static void Shutdown();
+	};
+}
+
+#endif // _TEXTURE_MANAGER_H_
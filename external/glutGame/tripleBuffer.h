@@ -0,0 +1,66 @@
+/*-------------------------------------------------------------------------\
+| File: TRIPLEBUFFER.H														|
+| Desc: Provides a lock free triple buffer, passing the newest complete		|
+|		value from one writing thread to one reading thread.				|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include <atomic>
+#include "uncopyable.h"
+
+namespace GameFramework
+{
+	/* The writer fills Back and publishes it, the reader acquires the newest published value as Front.
+	   Neither side ever waits - unread values are simply replaced by newer ones. */
+	template <typename T>
+	class TripleBuffer : private Uncopyable
+	{
+	private:
+		// Set on the shared index when it holds a value the reader has not yet taken
+		static const unsigned int FRESH = 4;
+		static const unsigned int INDEX_MASK = 3;
+
+		T m_buffers[3];
+
+		/* Index of the buffer between writer and reader, plus the FRESH flag */
+		std::atomic<unsigned int> m_shared;
+
+		/* Owned by the writer and reader respectively */
+		unsigned int m_back;
+		unsigned int m_front;
+	public:
+		TripleBuffer() : m_shared(1), m_back(0), m_front(2) { }
+
+		/* Writer side - the buffer to fill next. Holds the contents it had three publishes ago. */
+		T& Back()
+		{
+			return m_buffers[m_back];
+		}
+
+		/* Writer side - hands Back to the reader, and takes another buffer to fill */
+		void Publish()
+		{
+			m_back = m_shared.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+		}
+
+		/* Reader side - takes the newest published buffer as Front. Returns false (keeping Front) if nothing new was published. */
+		bool Acquire()
+		{
+			if ((m_shared.load(std::memory_order_relaxed) & FRESH) == 0)
+				return false;
+
+			m_front = m_shared.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+			return true;
+		}
+
+		/* Reader side - the most recently acquired buffer */
+		const T& Front() const
+		{
+			return m_buffers[m_front];
+		}
+	};
+}
+
+#endif // _TRIPLE_BUFFER_H_
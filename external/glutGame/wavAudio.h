@@ -0,0 +1,70 @@
+/*-------------------------------------------------------------------------\
+| File: WAVAUDIO.H															|
+| Desc: Provides declarations for an audio backend mixing everything it	|
+|		plays into a WAV file, for checking a run's audio offline.			|
+| Definition File: WAVAUDIO.CPP												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _WAV_AUDIO_H_
+#define _WAV_AUDIO_H_
+
+#include "audio.h"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <chrono>
+
+// Format the WAV backend mixes and writes, 16 bit stereo
+#define WAV_OUTPUT_RATE 44100
+#define WAV_OUTPUT_CHANNELS 2
+
+namespace GameFramework
+{
+	/* Reads 8 or 16 bit PCM WAV files, converted to the output format when loaded. Output is mixed in step with the clock,
+	   so a sound played n seconds after Init starts n seconds into the file. Music is decoded whole rather than streamed. */
+	class WavAudioBackend : public AudioBackend
+	{
+	private:
+		struct WavVoice
+		{
+			bool playing;
+			size_t position;			// Next frame to mix
+			unsigned long long started; // Output frame it was last started at
+		};
+
+		struct WavSound
+		{
+			std::vector<short> frames; // Interleaved, at the output rate
+			bool loop;
+			std::vector<WavVoice> voices; // One for music
+		};
+
+		/* Indexed by SoundID */
+		std::vector<WavSound> m_sounds;
+
+		std::string m_path;
+		std::ofstream m_file;
+		std::chrono::steady_clock::time_point m_start;
+		unsigned long long m_framesWritten;
+
+		std::vector<int> m_mix;
+		std::vector<short> m_output;
+
+		void Load(SoundID sound, const char* path, bool loop, unsigned int voices);
+
+		/* Mixes and writes frames up to the current time */
+		void MixTo(unsigned long long frame);
+	public:
+		WavAudioBackend(const std::string& path);
+
+		virtual bool Init() override;
+		virtual void Shutdown() override;
+		virtual void LoadSample(SoundID sound, const char* path, unsigned int voices) override;
+		virtual void LoadMusic(SoundID sound, const char* path) override;
+		virtual void Play(SoundID sound) override;
+		virtual void Stop(SoundID sound) override;
+		virtual void Update() override;
+	};
+}
+
+#endif // _WAV_AUDIO_H_
@@ -20,6 +20,7 @@
 // Log Files
 #define ENGINE_LOG "logMain.txt"
 
+/* Directory of the executable, with a trailing backslash. Found once, the buffer is shared and must not be freed. */
 char* GetCurrentDir();
 
 extern void InitLog(const char* fileName);
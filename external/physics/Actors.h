@@ -10,7 +10,7 @@
 #include "Physics.h"
 #include "log.h"
 #include "vertexSet.h"
-#include "loadImage.h"
+#include "textureManager.h"
 
 namespace Physics
 {
@@ -28,8 +28,7 @@ namespace Physics
 	class Actor
 	{
 	private:
-		bool m_textured;
-		unsigned int m_texID;
+		GameFramework::TextureHandle m_texture;
 		
 	protected:
 		ActorUnion m_actor;
@@ -41,6 +40,8 @@ namespace Physics
 	public:
 		Actor();
 		Actor(Transform pose, Fl32 density, ActorType m_aType);
+		/* Wraps an actor that was already built (e.g. read back from a CollectionCache), taking its type and pose from it */
+		Actor(PxRigidActor* actor);
 		Actor(const Actor& param);
 		virtual Actor& operator=(const Actor& param);
 		virtual ~Actor();
@@ -51,6 +52,9 @@ namespace Physics
 
 		virtual ActorUnion Get();
 
+		/* The actor, whether static or dynamic */
+		PxRigidActor* GetRigidActor();
+
 		bool IsTextured() const;
 		unsigned int TextureID() const;
 		
@@ -69,6 +73,8 @@ namespace Physics
 	protected:
 		ShapeActor(Transform pose = IDENTITY_TRANS, Fl32 density = DEFAULT_DENSITY, PxMaterial* material = DEFAULT_MATERIAL,
 			Vec3 color = DEFAULT_COLOR, ActorType aType = DEFAULT_ACTOR_TYPE);
+		/* Wraps a built actor with a single shape, taking the geometry and material from it */
+		ShapeActor(PxRigidActor* actor, Vec3 color);
 		ShapeActor(const ShapeActor& param);
 		virtual ShapeActor& operator=(const ShapeActor& param);
 
@@ -104,6 +110,8 @@ namespace Physics
 	public:
 		CompoundShapeActor(int numberOfShapes = 0, Transform pose = IDENTITY_TRANS, Fl32 density = DEFAULT_DENSITY, PxMaterial* material = DEFAULT_MATERIAL,
 			Vec3 color = DEFAULT_COLOR, ActorType aType = DEFAULT_ACTOR_TYPE);
+		/* Wraps a built actor, taking the geometry from its shapes and the material from the first */
+		CompoundShapeActor(PxRigidActor* actor, Vec3 color);
 		CompoundShapeActor(const CompoundShapeActor& param);
 		virtual CompoundShapeActor& operator=(const CompoundShapeActor& param);
 
@@ -123,6 +131,8 @@ namespace Physics
 		Box(Transform pose = IDENTITY_TRANS, Vec3 dimensions = Vec3(.5f, .5f, .5f),
 			Fl32 density = DEFAULT_DENSITY, const Vec3& color = DEFAULT_COLOR,
 			PxMaterial* material = DEFAULT_MATERIAL, ActorType aType = DEFAULT_ACTOR_TYPE);
+		/* Wraps a built box actor */
+		Box(PxRigidActor* actor, const Vec3& color);
 		Box(const Box& param);
 		virtual Box& operator=(const Box& param);
 		virtual ~Box();
@@ -158,11 +168,20 @@ namespace Physics
 	public:
 		ConvexMeshActor(VertexSet verts, Transform pose = IDENTITY_TRANS, Fl32 density = DEFAULT_DENSITY, const Vec3& color = DEFAULT_COLOR,
 			PxMaterial* material = DEFAULT_MATERIAL, Vec3 scale = Vec3(1, 1, 1), ActorType aType = DEFAULT_ACTOR_TYPE);
+		/* Instances an already cooked mesh, scaled by the shape rather than recooked (see WedgeDesc and PyramidDesc) */
+		ConvexMeshActor(PxConvexMesh* mesh, Transform pose = IDENTITY_TRANS, Fl32 density = DEFAULT_DENSITY, const Vec3& color = DEFAULT_COLOR,
+			PxMaterial* material = DEFAULT_MATERIAL, Vec3 scale = Vec3(1, 1, 1), ActorType aType = DEFAULT_ACTOR_TYPE);
+		/* Wraps a built convex mesh actor, its mesh and scale already on the shape */
+		ConvexMeshActor(PxRigidActor* actor, const Vec3& color);
 		ConvexMeshActor(const ConvexMeshActor& param);
 		virtual ConvexMeshActor& operator=(const ConvexMeshActor& param);
 		virtual ~ConvexMeshActor();
 
 		virtual void Create() override;
+
+		/* Descriptions of the unit meshes, cooked together with CookAll and shared between actors */
+		static PxConvexMeshDesc WedgeDesc();
+		static PxConvexMeshDesc PyramidDesc();
 		
 		static ConvexMeshActor* CreateWedge(Transform pose = IDENTITY_TRANS, Fl32 density = DEFAULT_DENSITY, const Vec3& color = DEFAULT_COLOR,
 			PxMaterial* material = DEFAULT_MATERIAL, Vec3 scale = Vec3(1, 1, 1), ActorType aType = DEFAULT_ACTOR_TYPE);
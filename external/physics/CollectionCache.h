@@ -0,0 +1,51 @@
+/*-------------------------------------------------------------------------\
+| File: COLLECTIONCACHE.H													|
+| Desc: Declarations for an on disk cache of PhysX objects, kept as a		|
+|		binary collection and deserialized in place.						|
+| Definition File: COLLECTIONCACHE.CPP										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef COLLECTION_CACHE_H
+#define COLLECTION_CACHE_H
+
+#include "globals.h"
+#include "Physics.h"
+#include <string>
+#include <vector>
+
+// Starting value of a key built with CollectionCache::Hash (the FNV-1a offset basis)
+#define COLLECTION_HASH_SEED 14695981039346656037ull
+
+namespace Physics
+{
+	using namespace physx;
+
+	/* A cache file holds one collection - the objects given IDs when it was written, and everything they reference (shapes,
+	   materials, cooked meshes). It is only read back for the same key (a hash of whatever the objects were built from) and
+	   PhysX version. Deserialized objects live in memory owned here, so it must be kept until the physics object is released. */
+	class CollectionCache
+	{
+	private:
+		/* Memory cached collections were deserialized into */
+		static std::vector<void*> m_blocks;
+	public:
+		/* Deserializes the collection at path if it was written with key, NULL if there isn't one or it can't be used. The
+		   objects are the caller's, releasing the collection leaves them. */
+		static PxCollection* Read(const std::string& path, unsigned long long key);
+
+		/* Adds everything the collection's objects reference to it, then writes it to path for the next run */
+		static bool Write(const std::string& path, unsigned long long key, PxCollection& collection);
+
+		/* Releases the objects of a collection that was read but couldn't be used. Joints go first, then actors (with their
+		   shapes), then what is left. */
+		static void ReleaseObjects(PxCollection& collection);
+
+		/* Frees the memory of deserialized objects. Called by PxRelease, once the physics object (and so every object) is released. */
+		static void Release();
+
+		/* Accumulates an FNV-1a hash, for building keys */
+		static void Hash(unsigned long long& hash, const void* data, size_t size);
+	};
+}
+
+#endif // COLLECTION_CACHE_H
@@ -39,6 +39,8 @@ namespace Physics
 	// -- Convex Mesh Functions
 	PxConvexMesh* CreateConvexMesh(Vec3* const verts, const int& nVerts, const Vec3& scale);
 	PxConvexMesh* Cook(const PxConvexMeshDesc& desc);
+	PxConvexMeshDesc ConvexMeshDesc(const Vec3* verts, const int& nVerts);
+	std::vector<PxConvexMesh*> CookAll(const std::vector<PxConvexMeshDesc>& descs);
 
 	enum ActorType
 	{
@@ -77,6 +79,7 @@ namespace Physics
 			PxScene* m_scene;
 			SimulationEventCallback* m_eventCallback;
 			bool m_pause;
+			unsigned int m_generation;
 
 		public:
 			Scene();
@@ -94,6 +97,13 @@ namespace Physics
 			std::vector<PxRigidActor*> GetActors(PxActorTypeSelectionFlags flags, bool rendering = false) const;
 
 			void Add(Actor* actor);
+
+			/* Adds actors in one batch, creating any that haven't been */
+			void Add(const std::vector<Actor*>& actors);
+
+			/* Changes whenever actors are added, so anything cached per actor pointer knows a new actor may have taken a
+			   released one's address */
+			unsigned int Generation() const;
 	};
 }
 
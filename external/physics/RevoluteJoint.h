@@ -15,6 +15,9 @@ namespace Physics
 	public:
 		RevoluteJoint();
 		RevoluteJoint(PxRigidActor* actor0, Transform& localFrame0, PxRigidActor* actor1, Transform& localFrame1);
+		/* Wraps a joint that was already built (e.g. read back from a CollectionCache) */
+		RevoluteJoint(PxRevoluteJoint* joint);
+		PxRevoluteJoint* Get() const;
 		void DriveVelocity(Fl32 value);
 		Fl32 GetDriveVelocity() const;
 		void SetLimits(Fl32 lower, Fl32 upper);
@@ -17,6 +17,7 @@ namespace GameFramework
 		void Set(const int& hours, const int& minutes, const double& seconds, const double& milliseconds);
 
 		void Reset();
+		/* Advances the timer by deltaTime seconds */
 		void Update(double deltaTime);
 
 		double Milliseconds();
@@ -0,0 +1,295 @@
+/*-------------------------------------------------------------------------\
+| File: ASSETARCHIVE.CPP													|
+| Desc: Provides definitions for a packed archive of the game's assets,	|
+|		memory mapped once and read through views into the mapping.			|
+| Declaration File: ASSETARCHIVE.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "assetArchive.h"
+#include "log.h"
+#include "fileUtil.h"
+#include <Windows.h>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+
+namespace GameFramework
+{
+	static const unsigned int ARCHIVE_MAGIC = 0x52414250; // "PBAR"
+	static const unsigned int ARCHIVE_VERSION = 1;
+
+	// Asset data is aligned in the archive, so views can be read in place
+	static const unsigned int ARCHIVE_ALIGNMENT = 16;
+
+	/* Start of the archive. The table of contents follows, sorted by name, then the names, then the data. */
+	struct ArchiveHeader
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int count;
+		unsigned int reserved;
+	};
+
+	/* Offsets are from the start of the archive */
+	struct ArchiveEntry
+	{
+		unsigned int nameOffset;
+		unsigned int nameLength;
+		unsigned int dataOffset;
+		unsigned int size;
+		unsigned long long modified;
+	};
+
+	// Packed names are lower case with forward slashes, lookups are normalized to match as they are compared
+	static unsigned char Normalize(char c)
+	{
+		if (c == '\\')
+			return '/';
+		return (unsigned char)tolower((unsigned char)c);
+	}
+
+	// Compares directory + "/" + name (or just name, if directory is NULL) with a packed name, ordered as strcmp
+	static int Compare(const char* directory, const char* name, const char* packed, unsigned int packedLength)
+	{
+		const char* parts[3] = { directory, directory ? "/" : NULL, name };
+		unsigned int i = 0;
+		for (int p = 0; p < 3; p++)
+		{
+			for (const char* c = parts[p]; c != NULL && *c != '\0'; c++, i++)
+			{
+				if (i == packedLength)
+					return 1;
+
+				int difference = (int)Normalize(*c) - (int)(unsigned char)packed[i];
+				if (difference != 0)
+					return difference;
+			}
+		}
+		return i == packedLength ? 0 : -1;
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							ASSET ARCHIVE DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	void* AssetArchive::m_file = NULL;
+	void* AssetArchive::m_mapping = NULL;
+	const unsigned char* AssetArchive::m_base = NULL;
+	unsigned int AssetArchive::m_count = 0;
+
+	bool AssetArchive::Open(const std::string& path)
+	{
+		Close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		HANDLE mapping = NULL;
+		const unsigned char* base = NULL;
+		if (GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG)sizeof(ArchiveHeader) && size.QuadPart < 0xFFFFFFFF)
+		{
+			mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping != NULL)
+				base = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		}
+
+		// Check every entry once here, so lookups can trust the table of contents
+		bool valid = base != NULL;
+		if (valid)
+		{
+			unsigned long long length = (unsigned long long)size.QuadPart;
+			const ArchiveHeader* header = (const ArchiveHeader*)base;
+			valid = header->magic == ARCHIVE_MAGIC && header->version == ARCHIVE_VERSION &&
+				sizeof(ArchiveHeader) + (unsigned long long)header->count * sizeof(ArchiveEntry) <= length;
+
+			const ArchiveEntry* entries = (const ArchiveEntry*)(base + sizeof(ArchiveHeader));
+			for (unsigned int i = 0; valid && i < header->count; i++)
+			{
+				valid = (unsigned long long)entries[i].nameOffset + entries[i].nameLength <= length &&
+					(unsigned long long)entries[i].dataOffset + entries[i].size <= length;
+			}
+
+			if (valid)
+				m_count = header->count;
+		}
+
+		if (!valid)
+		{
+			Log::Write(("Exc: Asset archive " + path + " could not be mapped, using loose files\n").c_str(), ENGINE_LOG);
+			if (base != NULL)
+				UnmapViewOfFile(base);
+			if (mapping != NULL)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_base = base;
+
+		Log::Write(("Mapped asset archive, " + std::to_string(m_count) + " assets\n").c_str(), ENGINE_LOG);
+		return true;
+	}
+
+	void AssetArchive::Close()
+	{
+		if (m_base != NULL)
+			UnmapViewOfFile(m_base);
+		if (m_mapping != NULL)
+			CloseHandle(m_mapping);
+		if (m_file != NULL)
+			CloseHandle(m_file);
+
+		m_base = NULL;
+		m_mapping = m_file = NULL;
+		m_count = 0;
+	}
+
+	bool AssetArchive::IsOpen()
+	{
+		return m_base != NULL;
+	}
+
+	bool AssetArchive::Find(const char* path, AssetView& view)
+	{
+		return Find(NULL, path, view);
+	}
+
+	bool AssetArchive::Find(const char* directory, const char* name, AssetView& view)
+	{
+		if (m_base == NULL)
+			return false;
+
+		const ArchiveEntry* entries = (const ArchiveEntry*)(m_base + sizeof(ArchiveHeader));
+
+		// Binary search of the sorted table of contents
+		unsigned int low = 0, high = m_count;
+		while (low < high)
+		{
+			unsigned int middle = low + (high - low) / 2;
+			const ArchiveEntry& entry = entries[middle];
+
+			int order = Compare(directory, name, (const char*)m_base + entry.nameOffset, entry.nameLength);
+			if (order == 0)
+			{
+				view.data = m_base + entry.dataOffset;
+				view.size = entry.size;
+				view.modified = entry.modified;
+				return true;
+			}
+
+			if (order < 0)
+				high = middle;
+			else
+				low = middle + 1;
+		}
+
+		return false;
+	}
+
+	bool AssetArchive::Pack(const std::string& root, const std::string& path)
+	{
+		Log::Write(("Packing assets into " + path + "...\n").c_str(), ENGINE_LOG);
+
+		struct PackedFile
+		{
+			std::string name, source;
+			unsigned long long modified;
+			unsigned int size;
+		};
+		std::vector<PackedFile> files;
+
+		const char* directories[] = ASSET_ARCHIVE_DIRS;
+		for (size_t d = 0; d < sizeof(directories) / sizeof(directories[0]); d++)
+		{
+			WIN32_FIND_DATAA found;
+			HANDLE find = FindFirstFileA((root + directories[d] + "\\*").c_str(), &found);
+			if (find == INVALID_HANDLE_VALUE)
+				continue;
+
+			do
+			{
+				if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+					continue;
+
+				PackedFile file;
+				file.source = root + directories[d] + "\\" + found.cFileName;
+				file.modified = ((unsigned long long)found.ftLastWriteTime.dwHighDateTime << 32) | found.ftLastWriteTime.dwLowDateTime;
+				file.size = found.nFileSizeLow;
+
+				std::string name = std::string(directories[d]) + "/" + found.cFileName;
+				for (size_t i = 0; i < name.size(); i++)
+					file.name += (char)Normalize(name[i]);
+
+				files.push_back(file);
+			} while (FindNextFileA(find, &found));
+
+			FindClose(find);
+		}
+
+		std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) { return a.name < b.name; });
+
+		// Lay out the table of contents, names and (aligned) data
+		std::vector<ArchiveEntry> entries(files.size());
+		unsigned long long offset = sizeof(ArchiveHeader) + files.size() * sizeof(ArchiveEntry);
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			entries[i].nameOffset = (unsigned int)offset;
+			entries[i].nameLength = files[i].name.size();
+			offset += files[i].name.size();
+		}
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			offset = (offset + ARCHIVE_ALIGNMENT - 1) / ARCHIVE_ALIGNMENT * ARCHIVE_ALIGNMENT;
+			entries[i].dataOffset = (unsigned int)offset;
+			entries[i].size = files[i].size;
+			entries[i].modified = files[i].modified;
+			offset += files[i].size;
+		}
+
+		if (offset >= 0xFFFFFFFF)
+		{
+			Log::Write("Err: Assets too large for a single archive!\n", ENGINE_LOG);
+			return false;
+		}
+
+		AtomicFile output(path);
+		if (!output.IsOpen())
+			return false;
+
+		std::ofstream& archive = output.Stream();
+		ArchiveHeader header = { ARCHIVE_MAGIC, ARCHIVE_VERSION, (unsigned int)files.size(), 0 };
+		archive.write((const char*)&header, sizeof(header));
+		if (!entries.empty())
+			archive.write((const char*)&entries[0], entries.size() * sizeof(ArchiveEntry));
+		for (size_t i = 0; i < files.size(); i++)
+			archive.write(files[i].name.c_str(), files[i].name.size());
+
+		std::vector<char> data;
+		for (size_t i = 0; i < files.size() && archive.good(); i++)
+		{
+			static const char padding[ARCHIVE_ALIGNMENT] = { 0 };
+			archive.write(padding, entries[i].dataOffset - (unsigned int)archive.tellp());
+
+			data.resize(files[i].size);
+			std::ifstream source(files[i].source.c_str(), std::ios::binary);
+			if (!source || (files[i].size > 0 && !source.read(&data[0], files[i].size)))
+			{
+				Log::Write(("Err: Could not read " + files[i].source + "!\n").c_str(), ENGINE_LOG);
+				archive.setstate(std::ios::failbit);
+				break;
+			}
+			if (files[i].size > 0)
+				archive.write(&data[0], files[i].size);
+		}
+
+		if (!output.Commit())
+			return false;
+
+		Log::Write(("Packed " + std::to_string(files.size()) + " assets\n").c_str(), ENGINE_LOG);
+		return true;
+	}
+}
@@ -0,0 +1,184 @@
+/*-------------------------------------------------------------------------\
+| File: AUDIO.CPP															|
+| Desc: Provides definitions for the game's audio, played by a				|
+|		swappable backend on an audio thread fed by a lock free queue.		|
+| Declaration File: AUDIO.H													|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "audio.h"
+#include "bassAudio.h"
+#include "wavAudio.h"
+#include "log.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+namespace GameFramework
+{
+	AudioBackend* Audio::m_backend = nullptr;
+	AudioBackendType Audio::m_type = AudioBackendType::Null;
+	AudioConfig Audio::m_config;
+	CommandQueue<AudioCommand, AUDIO_QUEUE_SIZE> Audio::m_commands;
+	std::thread Audio::m_thread;
+	std::atomic<bool> Audio::m_running(false);
+	std::atomic<SoundID> Audio::m_nextSound(1);
+
+	void Audio::Init(AudioBackendType type, const AudioConfig& config)
+	{
+		if (IsRunning())
+			return;
+
+		m_config = config;
+
+		switch (type)
+		{
+		case AudioBackendType::BASS:
+			Log::Write("Initializing audio (BASS)...\n", ENGINE_LOG);
+			m_backend = new BassAudioBackend(config.deviceBufferMs, config.updatePeriodMs);
+			break;
+		case AudioBackendType::WavWriter:
+			Log::Write("Initializing audio (WAV writer)...\n", ENGINE_LOG);
+			m_backend = new WavAudioBackend((std::string(Log::GetWorkingDir()) + AUDIO_WAV_OUTPUT).c_str());
+			break;
+		default:
+			Log::Write("Initializing audio (none)...\n", ENGINE_LOG);
+			m_backend = new NullAudioBackend();
+			break;
+		}
+		m_type = type;
+
+		if (!m_backend->Init())
+		{
+			Log::Write("Exc: Audio backend could not start, continuing without sound\n", ENGINE_LOG);
+			delete m_backend;
+			m_backend = new NullAudioBackend();
+			m_backend->Init();
+			m_type = AudioBackendType::Null;
+		}
+
+		m_running = true;
+		m_thread = std::thread(&Audio::ThreadLoop);
+	}
+
+	void Audio::Shutdown()
+	{
+		if (!IsRunning())
+			return;
+
+		m_running = false;
+		m_thread.join();
+
+		m_backend->Shutdown();
+		delete m_backend;
+		m_backend = nullptr;
+	}
+
+	bool Audio::IsRunning()
+	{
+		return m_thread.joinable();
+	}
+
+	AudioBackendType Audio::Backend()
+	{
+		return m_type;
+	}
+
+	void Audio::ThreadLoop()
+	{
+		AudioCommand command;
+		std::vector<SoundID> played;
+		played.reserve(AUDIO_QUEUE_SIZE);
+
+		for (;;)
+		{
+			// Read before draining, so commands queued ahead of Shutdown are still carried out
+			bool running = m_running;
+
+			played.clear();
+			while (m_commands.Pop(command))
+			{
+				if (command.type == AudioCommandType::Play)
+				{
+					if (std::find(played.begin(), played.end(), command.sound) != played.end())
+						continue;
+					played.push_back(command.sound);
+				}
+				else if (command.type == AudioCommandType::Stop)
+					played.erase(std::remove(played.begin(), played.end(), command.sound), played.end()); // Play after stop starts again
+
+				Execute(command);
+			}
+			m_backend->Update();
+
+			if (!running)
+				break;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(m_config.threadPeriodMs));
+		}
+	}
+
+	void Audio::Execute(const AudioCommand& command)
+	{
+		switch (command.type)
+		{
+		case AudioCommandType::LoadSample:
+			m_backend->LoadSample(command.sound, command.path, command.voices);
+			break;
+		case AudioCommandType::LoadMusic:
+			m_backend->LoadMusic(command.sound, command.path);
+			break;
+		case AudioCommandType::Play:
+			m_backend->Play(command.sound);
+			break;
+		case AudioCommandType::Stop:
+			m_backend->Stop(command.sound);
+			break;
+		}
+	}
+
+	bool Audio::Push(AudioCommandType type, SoundID sound, const char* path, unsigned int voices)
+	{
+		AudioCommand command;
+		command.type = type;
+		command.sound = sound;
+		command.path[0] = '\0';
+		command.voices = voices;
+
+		if (path != nullptr)
+		{
+			if (strlen(path) >= AUDIO_PATH_LENGTH)
+			{
+				Log::Write(("Err: Sound path too long, " + std::string(path) + "\n").c_str(), ENGINE_LOG);
+				return false;
+			}
+			strcpy_s(command.path, path);
+		}
+
+		return m_commands.Push(command);
+	}
+
+	SoundID Audio::LoadSample(const char* path, unsigned int voices)
+	{
+		SoundID sound = m_nextSound++;
+		return Push(AudioCommandType::LoadSample, sound, path, voices > 0 ? voices : 1) ? sound : 0;
+	}
+
+	SoundID Audio::LoadMusic(const char* path)
+	{
+		SoundID sound = m_nextSound++;
+		return Push(AudioCommandType::LoadMusic, sound, path) ? sound : 0;
+	}
+
+	void Audio::Play(SoundID sound)
+	{
+		if (sound != 0)
+			Push(AudioCommandType::Play, sound);
+	}
+
+	void Audio::Stop(SoundID sound)
+	{
+		if (sound != 0)
+			Push(AudioCommandType::Stop, sound);
+	}
+}
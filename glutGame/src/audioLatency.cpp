@@ -0,0 +1,162 @@
+/*-------------------------------------------------------------------------\
+| File: AUDIOLATENCY.CPP													|
+| Desc: Provides definitions for a benchmark measuring the time from a		|
+|		sound being triggered to it starting in the audio output.			|
+| Declaration File: AUDIOLATENCY.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "audioLatency.h"
+#include "wavAudio.h"
+#include "log.h"
+#include <Windows.h>
+#include <mmsystem.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <thread>
+
+namespace GameFramework
+{
+	// The click is a square pulse at CLICK_LEVEL from its first frame, so its onset in the output is exact
+	static const short CLICK_LEVEL = 16000;
+	static const unsigned int CLICK_FRAMES = WAV_OUTPUT_RATE / 100;
+
+	// Output at or above this level is a click
+	static const int ONSET_LEVEL = CLICK_LEVEL / 2;
+
+	// Path of a file in the working directory (beside the executable)
+	static std::string WorkingPath(const char* fileName)
+	{
+		const char* directory = Log::GetWorkingDir();
+		return std::string(directory ? directory : "") + fileName;
+	}
+
+	template <typename T>
+	static void WriteValue(std::ofstream& file, T value)
+	{
+		file.write((const char*)&value, sizeof(T));
+	}
+
+	// Writes the click as a 16 bit mono PCM WAV file at the output rate
+	static bool WriteClick(const std::string& path)
+	{
+		std::ofstream file(path.c_str(), std::ios::binary);
+		if (!file)
+			return false;
+
+		unsigned int dataSize = CLICK_FRAMES * 2;
+		file.write("RIFF", 4);
+		WriteValue(file, (unsigned int)(36 + dataSize));
+		file.write("WAVEfmt ", 8);
+		WriteValue(file, (unsigned int)16);
+		WriteValue(file, (unsigned short)1);
+		WriteValue(file, (unsigned short)1);
+		WriteValue(file, (unsigned int)WAV_OUTPUT_RATE);
+		WriteValue(file, (unsigned int)(WAV_OUTPUT_RATE * 2));
+		WriteValue(file, (unsigned short)2);
+		WriteValue(file, (unsigned short)16);
+		file.write("data", 4);
+		WriteValue(file, dataSize);
+		for (unsigned int i = 0; i < CLICK_FRAMES; i++)
+			WriteValue(file, CLICK_LEVEL);
+
+		return file.good();
+	}
+
+	int AudioLatencyBenchmark::Run(int hits, const AudioConfig& config)
+	{
+		std::string click = WorkingPath(AUDIO_LATENCY_CLICK);
+		if (!WriteClick(click))
+		{
+			Log::Write(("Err: Could not write " + click + "!\n").c_str(), ENGINE_LOG);
+			return 2;
+		}
+
+		// As in game, so the audio thread sleeps for its period rather than the default scheduler tick
+		timeBeginPeriod(1);
+
+		// The backend's clock (frame 0 of the output) starts inside Init, so latencies read a few microseconds high
+		Audio::Init(AudioBackendType::WavWriter, config);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if (Audio::Backend() != AudioBackendType::WavWriter)
+		{
+			Audio::Shutdown();
+			timeEndPeriod(1);
+			return 2;
+		}
+
+		SoundID sound = Audio::LoadSample(click.c_str(), 1);
+
+		// Seconds since the output started that each click was played at
+		std::vector<double> triggers;
+		for (int i = 0; i < hits; i++)
+		{
+			std::this_thread::sleep_until(start + std::chrono::milliseconds(AUDIO_LATENCY_INTERVAL_MS * (i + 1)));
+			triggers.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+			Audio::Play(sound);
+		}
+
+		// Long enough for the last click to be written
+		std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_LATENCY_INTERVAL_MS));
+		Audio::Shutdown();
+		timeEndPeriod(1);
+
+		// Written by the backend, a canonical 44 byte header and then interleaved 16 bit frames
+		std::ifstream output(WorkingPath(AUDIO_WAV_OUTPUT).c_str(), std::ios::binary);
+		std::vector<char> bytes((std::istreambuf_iterator<char>(output)), std::istreambuf_iterator<char>());
+		const short* samples = bytes.size() > 44 ? (const short*)&bytes[44] : nullptr;
+		size_t frames = bytes.size() > 44 ? (bytes.size() - 44) / (WAV_OUTPUT_CHANNELS * 2) : 0;
+
+		std::stringstream report;
+		report << std::fixed << std::setprecision(3);
+		report << "Audio latency benchmark - " << hits << " clicks, audio thread period " << config.threadPeriodMs << "ms\n";
+
+		std::vector<double> latencies;
+		size_t window = WAV_OUTPUT_RATE * AUDIO_LATENCY_INTERVAL_MS / 1000;
+		for (size_t i = 0; i < triggers.size(); i++)
+		{
+			// The first loud frame at or after the trigger
+			size_t first = (size_t)(triggers[i] * WAV_OUTPUT_RATE);
+			size_t onset = first;
+			while (onset < frames && onset < first + window && abs(samples[onset * WAV_OUTPUT_CHANNELS]) < ONSET_LEVEL)
+				onset++;
+
+			if (onset >= frames || onset >= first + window)
+			{
+				report << "Click " << i + 1 << " missing\n";
+				Log::Write(report.str().c_str(), AUDIO_LATENCY_LOG);
+				Log::Write(report.str().c_str(), ENGINE_LOG);
+				return 2;
+			}
+
+			double ms = ((double)onset / WAV_OUTPUT_RATE - triggers[i]) * 1000.0;
+			report << "Click " << i + 1 << ", " << ms << "ms\n";
+			latencies.push_back(ms);
+		}
+
+		if (latencies.empty())
+			return 2;
+
+		std::sort(latencies.begin(), latencies.end());
+		double median = latencies[latencies.size() / 2];
+		report << "Min, " << latencies.front() << "ms\n";
+		report << "Median, " << median << "ms\n";
+		report << "Max, " << latencies.back() << "ms\n";
+
+		int result = 0;
+		if (median > AUDIO_LATENCY_LIMIT_MS)
+		{
+			report << "FAILED - median over " << AUDIO_LATENCY_LIMIT_MS << "ms\n";
+			result = 1;
+		}
+		else
+			report << "Passed\n";
+
+		Log::Write(report.str().c_str(), AUDIO_LATENCY_LOG);
+		Log::Write(report.str().c_str(), ENGINE_LOG);
+		return result;
+	}
+}
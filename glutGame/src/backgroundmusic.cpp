@@ -1,24 +1,28 @@
 /*
 	File: BACKGROUNDMUSIC.CPP
 	Author: Henri Keeble
-	Desc: Defines functions for a class used to play background music in a game using BASS 2.4.
+	Desc: Defines functions for a class used to play background music in a game through the audio thread.
 */
 #include "backgroundmusic.h"
 
 namespace GameFramework
 {
-	BackgroundMusic::BackgroundMusic() : Sample()
+	BackgroundMusic::BackgroundMusic()
 	{
+		stream = 0;
 		isPlaying = false;
 	}
 
-	BackgroundMusic::BackgroundMusic(const char* filename) : Sample(filename)
+	BackgroundMusic::BackgroundMusic(const char* filename)
 	{
+		stream = 0;
 		isPlaying = false;
+		Load(filename);
 	}
 
-	BackgroundMusic::BackgroundMusic(const BackgroundMusic& param) : Sample(param)
+	BackgroundMusic::BackgroundMusic(const BackgroundMusic& param)
 	{
+		stream = param.stream;
 		isPlaying = param.isPlaying;
 	}
 
@@ -28,8 +32,8 @@ namespace GameFramework
 			return *this;
 		else
 		{
+			stream = param.stream;
 			isPlaying = param.isPlaying;
-			Sample::operator=(param);
 			return *this;
 		}
 	}
@@ -39,34 +43,50 @@ namespace GameFramework
 
 	}
 
-	void BackgroundMusic::Update()
+	void BackgroundMusic::Load(const char* filename)
 	{
-		if (BASS_ChannelIsActive(GetChannel()) != BASS_ACTIVE_PLAYING && isPlaying == true)
+		if (stream != 0)
+			Audio::Stop(stream);
+		isPlaying = false;
+
+		// Opened on the audio thread, which reports a file that can't be read
+		stream = Audio::LoadMusic(filename);
+
+		// Report of error in loading
+		if (stream == 0)
 		{
-			isPlaying = false;
-			Play();
+			Log::Write("Music ", ENGINE_LOG);
+			Log::Write(filename, ENGINE_LOG);
+			Log::Write(" not loaded correctly!\n", ENGINE_LOG);
 		}
 	}
 
 	void BackgroundMusic::Play()
 	{
-		if (isPlaying == false)
+		if (isPlaying == true)
+			return;
+
+		// If no stream, do not attempt to play
+		if (stream != 0)
 		{
 			isPlaying = true;
-			Sample::Play();
+			Audio::Play(stream); // Restarts from the beginning
 		}
 		else
-			return;
+			Log::Write("Error playing music, stream not loaded!\n", ENGINE_LOG);
 	}
 
 	void BackgroundMusic::Stop()
 	{
-		if (isPlaying == true)
-		{
-			isPlaying = false;
-			Sample::Stop();
-		}
-		else
+		if (isPlaying == false)
 			return;
+
+		isPlaying = false;
+		Audio::Stop(stream);
+	}
+
+	bool BackgroundMusic::IsPlaying() const
+	{
+		return isPlaying;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,128 @@
+/*-------------------------------------------------------------------------\
+| File: BASSAUDIO.CPP														|
+| Desc: Provides definitions for an audio backend playing through BASS.	|
+| Declaration File: BASSAUDIO.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "bassAudio.h"
+#include "assetArchive.h"
+#include "log.h"
+
+namespace GameFramework
+{
+	static void LogLoadError(const char* path)
+	{
+		Log::Write(("Sound " + std::string(path) + " not loaded correctly!\n").c_str(), ENGINE_LOG);
+	}
+
+	BassAudioBackend::BassAudioBackend(unsigned int deviceBufferMs, unsigned int updatePeriodMs)
+	{
+		m_deviceBufferMs = deviceBufferMs;
+		m_updatePeriodMs = updatePeriodMs;
+	}
+
+	bool BassAudioBackend::Init()
+	{
+		// The device buffer is read by BASS_Init
+		if (m_deviceBufferMs > 0)
+			BASS_SetConfig(BASS_CONFIG_DEV_BUFFER, m_deviceBufferMs);
+		if (m_updatePeriodMs > 0)
+			BASS_SetConfig(BASS_CONFIG_UPDATEPERIOD, m_updatePeriodMs);
+
+		if (!BASS_Init(-1, 44100, BASS_DEVICE_LATENCY, 0, 0))
+		{
+			Log::Write("Error initializing BASS!\n", ENGINE_LOG);
+			return false;
+		}
+
+		BASS_INFO info;
+		if (BASS_GetInfo(&info))
+			Log::Write(("BASS device latency " + std::to_string(info.latency) + "ms, minimum buffer " + std::to_string(info.minbuf) + "ms\n").c_str(), ENGINE_LOG);
+		return true;
+	}
+
+	void BassAudioBackend::Shutdown()
+	{
+		m_sounds.clear();
+		BASS_Free(); // Frees every sample and stream
+	}
+
+	BassAudioBackend::BassSound* BassAudioBackend::Find(SoundID sound)
+	{
+		return sound < m_sounds.size() ? &m_sounds[sound] : nullptr;
+	}
+
+	BassAudioBackend::BassSound& BassAudioBackend::Add(SoundID sound)
+	{
+		if (sound >= m_sounds.size())
+		{
+			BassSound none = { 0, 0 };
+			m_sounds.resize(sound + 1, none);
+		}
+		return m_sounds[sound];
+	}
+
+	void BassAudioBackend::LoadSample(SoundID sound, const char* path, unsigned int voices)
+	{
+		// BASS copies the data, so the archive's mapping is only read here
+		AssetView view;
+		HSAMPLE sample;
+		if (AssetArchive::Find(path, view))
+			sample = BASS_SampleLoad(true, view.data, 0, view.size, voices, BASS_SAMPLE_OVER_POS);
+		else
+			sample = BASS_SampleLoad(false, path, 0, 0, voices, BASS_SAMPLE_OVER_POS);
+
+		if (sample == 0)
+			LogLoadError(path);
+		Add(sound).sample = sample;
+	}
+
+	void BassAudioBackend::LoadMusic(SoundID sound, const char* path)
+	{
+		// The buffer length is read when a stream is created, so it is only changed for this one
+		DWORD buffer = BASS_GetConfig(BASS_CONFIG_BUFFER);
+		BASS_SetConfig(BASS_CONFIG_BUFFER, MUSIC_BUFFER_MS);
+
+		// Streams from memory read the archive's mapping in place, which stays open until after audio shuts down
+		AssetView view;
+		HSTREAM stream;
+		if (AssetArchive::Find(path, view))
+			stream = BASS_StreamCreateFile(true, view.data, 0, view.size, BASS_SAMPLE_LOOP);
+		else
+			stream = BASS_StreamCreateFile(false, path, 0, 0, BASS_SAMPLE_LOOP);
+
+		BASS_SetConfig(BASS_CONFIG_BUFFER, buffer);
+
+		if (stream == 0)
+			LogLoadError(path);
+		Add(sound).stream = stream;
+	}
+
+	void BassAudioBackend::Play(SoundID sound)
+	{
+		BassSound* s = Find(sound);
+		if (s == nullptr)
+			return;
+
+		if (s->stream != 0)
+			BASS_ChannelPlay(s->stream, true); // Restart from the beginning
+		else if (s->sample != 0)
+		{
+			// A free voice, or the longest playing one (BASS_SAMPLE_OVER_POS) restarted
+			HCHANNEL channel = BASS_SampleGetChannel(s->sample, false);
+			BASS_ChannelPlay(channel, true);
+		}
+	}
+
+	void BassAudioBackend::Stop(SoundID sound)
+	{
+		BassSound* s = Find(sound);
+		if (s == nullptr)
+			return;
+
+		if (s->stream != 0)
+			BASS_ChannelStop(s->stream);
+		else if (s->sample != 0)
+			BASS_SampleStop(s->sample); // Every voice
+	}
+}
@@ -32,6 +32,54 @@ void Camera::Update()
 				Up.x,		Up.y,		Up.z	);
 }
 
+GameFramework::Frustum Camera::GetFrustum(Fl32 aspect, Fl32 zNear, Fl32 zFar) const
+{
+	using namespace GameFramework;
+
+	// Camera basis, as gluLookAt builds it
+	Vec3 forward = (LookAt - EyePos).getNormalized();
+	Vec3 right = forward.cross(Up).getNormalized();
+	Vec3 up = right.cross(forward);
+
+	Fl32 tanY = tanf(DEG2RAD(FOV) * .5f);
+	Fl32 tanX = tanY * aspect;
+
+	Frustum frustum;
+	frustum.SetPlane(FrustumPlane::Near, physx::PxPlane(EyePos + forward * zNear, forward));
+	frustum.SetPlane(FrustumPlane::Far, physx::PxPlane(EyePos + forward * zFar, -forward));
+
+	// Side planes pass through the eye, normals point inwards
+	frustum.SetPlane(FrustumPlane::Left, physx::PxPlane(EyePos, (forward - right * tanX).cross(up).getNormalized()));
+	frustum.SetPlane(FrustumPlane::Right, physx::PxPlane(EyePos, up.cross(forward + right * tanX).getNormalized()));
+	frustum.SetPlane(FrustumPlane::Bottom, physx::PxPlane(EyePos, right.cross(forward - up * tanY).getNormalized()));
+	frustum.SetPlane(FrustumPlane::Top, physx::PxPlane(EyePos, (forward + up * tanY).cross(right).getNormalized()));
+
+	return frustum;
+}
+
+Mat44 Camera::GetViewMatrix() const
+{
+	Vec3 forward = (LookAt - EyePos).getNormalized();
+	Vec3 right = forward.cross(Up).getNormalized();
+	Vec3 up = right.cross(forward);
+
+	// Rows of the rotation are the camera basis, looking down -z
+	return Mat44(physx::PxVec4(right.x, up.x, -forward.x, 0.f),
+				 physx::PxVec4(right.y, up.y, -forward.y, 0.f),
+				 physx::PxVec4(right.z, up.z, -forward.z, 0.f),
+				 physx::PxVec4(-right.dot(EyePos), -up.dot(EyePos), forward.dot(EyePos), 1.f));
+}
+
+Mat44 Camera::GetProjectionMatrix(Fl32 aspect, Fl32 zNear, Fl32 zFar) const
+{
+	// As gluPerspective builds it
+	Fl32 f = 1.f / tanf(DEG2RAD(FOV) * .5f);
+	return Mat44(physx::PxVec4(f / aspect, 0.f, 0.f, 0.f),
+				 physx::PxVec4(0.f, f, 0.f, 0.f),
+				 physx::PxVec4(0.f, 0.f, (zFar + zNear) / (zNear - zFar), -1.f),
+				 physx::PxVec4(0.f, 0.f, 2.f * zFar * zNear / (zNear - zFar), 0.f));
+}
+
 Camera::~Camera()
 {
 
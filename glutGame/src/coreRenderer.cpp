@@ -0,0 +1,398 @@
+/*-------------------------------------------------------------------------\
+| File: CORERENDERER.CPP													|
+| Desc: Provides definitions for an OpenGL 3.3 core profile renderer,		|
+|		drawing frame snapshots with a single lit shader from vertex		|
+|		buffers uploaded once.												|
+| Declaration File: CORERENDERER.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "coreRenderer.h"
+#include "log.h"
+#include <cfloat>
+
+using namespace physx;
+
+namespace GameFramework
+{
+	using namespace GLCore;
+
+	// Binding point of the Frame uniform block
+	static const GLuint FRAME_BINDING = 0;
+
+	// Vertex attribute locations
+	static const GLuint ATTRIB_POSITION = 0;
+	static const GLuint ATTRIB_NORMAL = 1;
+
+	// Light of GLUTGame::InitGL - a directional light along +x in eye space. The ambient term includes the fixed function
+	// pipeline's default global ambient (.2) on top of the light's own (.5).
+	static const Fl32 LIGHT_AMBIENT = .7f;
+	static const Fl32 LIGHT_DIFFUSE = .4f;
+
+	static const char* VERTEX_SHADER_SOURCE =
+		"#version 330 core\n"
+		"layout(std140) uniform Frame\n"
+		"{\n"
+		"	mat4 view;\n"
+		"	mat4 projection;\n"
+		"	vec4 lightDirection;\n"
+		"	vec4 lighting;\n"
+		"};\n"
+		"uniform mat4 model;\n"
+		"uniform mat3 normalMatrix;\n"
+		"layout(location = 0) in vec3 position;\n"
+		"layout(location = 1) in vec3 normal;\n"
+		"out vec3 eyeNormal;\n"
+		"void main()\n"
+		"{\n"
+		"	eyeNormal = mat3(view) * (normalMatrix * normal);\n"
+		"	gl_Position = projection * view * model * vec4(position, 1.0);\n"
+		"}\n";
+
+	static const char* FRAGMENT_SHADER_SOURCE =
+		"#version 330 core\n"
+		"layout(std140) uniform Frame\n"
+		"{\n"
+		"	mat4 view;\n"
+		"	mat4 projection;\n"
+		"	vec4 lightDirection;\n"
+		"	vec4 lighting;\n"
+		"};\n"
+		"uniform vec3 color;\n"
+		"in vec3 eyeNormal;\n"
+		"out vec4 fragColor;\n"
+		"void main()\n"
+		"{\n"
+		"	float diffuse = max(dot(normalize(eyeNormal), lightDirection.xyz), 0.0);\n"
+		"	fragColor = vec4(min(color * (lighting.x + lighting.y * diffuse), 1.0), 1.0);\n"
+		"}\n";
+
+	// Compiles a shader, logging the driver's messages on failure. Returns 0 on failure.
+	static GLuint CompileStage(GLenum type, const char* source)
+	{
+		GLuint shader = CreateShader(type);
+		ShaderSource(shader, 1, &source, NULL);
+		CompileShader(shader);
+
+		GLint status = 0;
+		GetShaderiv(shader, COMPILE_STATUS, &status);
+		if (!status)
+		{
+			GLint length = 0;
+			GetShaderiv(shader, INFO_LOG_LENGTH, &length);
+			std::string info(length > 0 ? length : 1, '\0');
+			GetShaderInfoLog(shader, info.size(), NULL, &info[0]);
+
+			Log::Write("Shader compilation failed:\n", ENGINE_LOG);
+			Log::Write(info.c_str(), ENGINE_LOG);
+			DeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+
+	// Model matrix of a shape scaled along its local axes, and the matrix taking its normals to world space
+	static void ScaledModel(const Mat44& pose, const Vec3& scale, Mat44& model, Mat33& normalMatrix)
+	{
+		Vec3 x = pose.column0.getXYZ(), y = pose.column1.getXYZ(), z = pose.column2.getXYZ();
+		model = Mat44(PxVec4(x * scale.x, 0.f), PxVec4(y * scale.y, 0.f), PxVec4(z * scale.z, 0.f), pose.column3);
+		normalMatrix = Mat33(x * (1.f / scale.x), y * (1.f / scale.y), z * (1.f / scale.z)); // Inverse transpose of rotation * scale
+	}
+
+	CoreRenderer::CoreRenderer()
+	{
+		m_ready = false;
+		m_program = 0;
+		m_modelLoc = m_normalMatrixLoc = m_colorLoc = -1;
+		m_frameUniforms = 0;
+	}
+
+	CoreRenderer::~CoreRenderer()
+	{
+
+	}
+
+	bool CoreRenderer::Init()
+	{
+		Log::Write("Initializing core profile renderer...\n", ENGINE_LOG);
+
+		if (!GLCore::Load() || !BuildProgram())
+			return false;
+
+		GenBuffers(1, &m_frameUniforms);
+		BindBuffer(UNIFORM_BUFFER, m_frameUniforms);
+		BufferData(UNIFORM_BUFFER, sizeof(FrameUniforms), NULL, DYNAMIC_DRAW);
+		BindBuffer(UNIFORM_BUFFER, 0);
+
+		// Unit cube (half extents of 1), four vertices per face so each face has its own normal
+		static const GLfloat FACE_NORMALS[6][3] = { { 0, 0, -1 }, { 0, 0, 1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 } };
+		std::vector<MeshVertex> vertices;
+		std::vector<GLushort> indices;
+		for (int f = 0; f < 6; f++)
+		{
+			Vec3 n(FACE_NORMALS[f][0], FACE_NORMALS[f][1], FACE_NORMALS[f][2]);
+			Vec3 u(n.y, n.z, n.x); // Perpendicular axes spanning the face, u x v == n
+			Vec3 v = n.cross(u);
+
+			GLushort base = (GLushort)vertices.size();
+			const Fl32 corners[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+			for (int c = 0; c < 4; c++)
+			{
+				Vec3 p = n + u * corners[c][0] + v * corners[c][1];
+				MeshVertex vertex = { n.x, n.y, n.z, p.x, p.y, p.z };
+				vertices.push_back(vertex);
+			}
+
+			const GLushort quad[6] = { 0, 1, 2, 0, 2, 3 };
+			for (int i = 0; i < 6; i++)
+				indices.push_back(base + quad[i]);
+		}
+		m_cube = Upload(vertices, indices);
+
+		m_sphereLODs.Build();
+		for (int i = 0; i < SPHERE_LOD_COUNT; i++)
+			m_spheres[i] = Upload(m_sphereLODs.Level(i).Vertices(), m_sphereLODs.Level(i).Indices());
+
+		m_ready = true;
+		return true;
+	}
+
+	bool CoreRenderer::BuildProgram()
+	{
+		GLuint vertexShader = CompileStage(VERTEX_SHADER, VERTEX_SHADER_SOURCE);
+		GLuint fragmentShader = CompileStage(FRAGMENT_SHADER, FRAGMENT_SHADER_SOURCE);
+		if (vertexShader == 0 || fragmentShader == 0)
+		{
+			if (vertexShader) DeleteShader(vertexShader);
+			if (fragmentShader) DeleteShader(fragmentShader);
+			return false;
+		}
+
+		m_program = CreateProgram();
+		AttachShader(m_program, vertexShader);
+		AttachShader(m_program, fragmentShader);
+		LinkProgram(m_program);
+
+		// The program keeps the compiled stages alive
+		DeleteShader(vertexShader);
+		DeleteShader(fragmentShader);
+
+		GLint status = 0;
+		GetProgramiv(m_program, LINK_STATUS, &status);
+		if (!status)
+		{
+			GLint length = 0;
+			GetProgramiv(m_program, INFO_LOG_LENGTH, &length);
+			std::string info(length > 0 ? length : 1, '\0');
+			GetProgramInfoLog(m_program, info.size(), NULL, &info[0]);
+
+			Log::Write("Shader program link failed:\n", ENGINE_LOG);
+			Log::Write(info.c_str(), ENGINE_LOG);
+			DeleteProgram(m_program);
+			m_program = 0;
+			return false;
+		}
+
+		GLuint block = GetUniformBlockIndex(m_program, "Frame");
+		if (block == INVALID_INDEX)
+		{
+			Log::Write("Shader program has no Frame uniform block!\n", ENGINE_LOG);
+			return false;
+		}
+		UniformBlockBinding(m_program, block, FRAME_BINDING);
+
+		m_modelLoc = GetUniformLocation(m_program, "model");
+		m_normalMatrixLoc = GetUniformLocation(m_program, "normalMatrix");
+		m_colorLoc = GetUniformLocation(m_program, "color");
+		return true;
+	}
+
+	GpuMesh CoreRenderer::Upload(const std::vector<MeshVertex>& vertices, const std::vector<GLushort>& indices)
+	{
+		GpuMesh mesh;
+		if (indices.empty())
+			return mesh;
+
+		GenVertexArrays(1, &mesh.vao);
+		BindVertexArray(mesh.vao);
+
+		GenBuffers(1, &mesh.vbo);
+		BindBuffer(ARRAY_BUFFER, mesh.vbo);
+		BufferData(ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex), &vertices[0], STATIC_DRAW);
+
+		GenBuffers(1, &mesh.ibo);
+		BindBuffer(ELEMENT_ARRAY_BUFFER, mesh.ibo);
+		BufferData(ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), &indices[0], STATIC_DRAW);
+		mesh.indexCount = indices.size();
+
+		EnableVertexAttribArray(ATTRIB_NORMAL);
+		VertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (const void*)offsetof(MeshVertex, nx));
+		EnableVertexAttribArray(ATTRIB_POSITION);
+		VertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (const void*)offsetof(MeshVertex, x));
+
+		// The element buffer binding belongs to the vertex array, so unbind that first
+		BindVertexArray(0);
+		BindBuffer(ARRAY_BUFFER, 0);
+		BindBuffer(ELEMENT_ARRAY_BUFFER, 0);
+		return mesh;
+	}
+
+	const GpuMesh& CoreRenderer::ConvexMesh(const PxConvexMesh* mesh)
+	{
+		std::map<const PxConvexMesh*, GpuMesh>::iterator found = m_convexMeshes.find(mesh);
+		if (found != m_convexMeshes.end())
+			return found->second;
+
+		const PxU32 nbPolys = mesh->getNbPolygons();
+		const PxU8* polygons = mesh->getIndexBuffer();
+		const PxVec3* verts = mesh->getVertices();
+
+		// Each polygon gets its own copies of its vertices, carrying the polygon's normal
+		std::vector<MeshVertex> vertices;
+		std::vector<GLushort> indices;
+		for (PxU32 i = 0; i < nbPolys; i++)
+		{
+			PxHullPolygon data;
+			mesh->getPolygonData(i, data);
+
+			if (vertices.size() + data.mNbVerts > 0xFFFF)
+			{
+				Log::Write("Exc: Convex mesh too large for 16 bit indices, truncated\n", ENGINE_LOG);
+				break;
+			}
+
+			GLushort base = (GLushort)vertices.size();
+			for (PxU32 j = 0; j < data.mNbVerts; j++)
+			{
+				const PxVec3& p = verts[polygons[data.mIndexBase + j]];
+				MeshVertex vertex = { data.mPlane[0], data.mPlane[1], data.mPlane[2], p.x, p.y, p.z };
+				vertices.push_back(vertex);
+			}
+
+			// Fan out from the polygon's first vertex
+			for (PxU32 j = 1; j + 1 < data.mNbVerts; j++)
+			{
+				indices.push_back(base);
+				indices.push_back(base + j);
+				indices.push_back(base + j + 1);
+			}
+		}
+
+		return m_convexMeshes[mesh] = Upload(vertices, indices);
+	}
+
+	void CoreRenderer::Draw(const GpuMesh& mesh, const Mat44& model, const Mat33& normalMatrix, const Vec3& color)
+	{
+		if (mesh.indexCount == 0)
+			return;
+
+		UniformMatrix4fv(m_modelLoc, 1, GL_FALSE, &model.column0.x);
+		UniformMatrix3fv(m_normalMatrixLoc, 1, GL_FALSE, &normalMatrix.column0.x);
+		Uniform3fv(m_colorLoc, 1, &color.x);
+
+		BindVertexArray(mesh.vao);
+		glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_SHORT, NULL);
+	}
+
+	void CoreRenderer::Render(const FrameSnapshot& snapshot, Fl32 alpha, const Mat44& view, const Mat44& projection,
+		const std::map<const PxConvexMesh*, PxConvexMesh*>& simplifiedHulls)
+	{
+		if (!m_ready)
+			return;
+
+		FrameUniforms frame;
+		frame.view = view;
+		frame.projection = projection;
+		frame.lightDirection = PxVec4(1.f, 0.f, 0.f, 0.f);
+		frame.lighting = PxVec4(LIGHT_AMBIENT, LIGHT_DIFFUSE, 0.f, 0.f);
+
+		BindBuffer(UNIFORM_BUFFER, m_frameUniforms);
+		BufferSubData(UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+		BindBuffer(UNIFORM_BUFFER, 0);
+		BindBufferBase(UNIFORM_BUFFER, FRAME_BINDING, m_frameUniforms);
+
+		UseProgram(m_program);
+
+		// Pixels covered by one unit at a distance of one unit along the view axis, for picking levels of detail
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		const Fl32 pixelScale = projection.column1.y * viewport[3] * .5f;
+
+		for (std::vector<ShapeDraw>::const_iterator iter = snapshot.shapes.begin(); iter != snapshot.shapes.end(); iter++)
+		{
+			Mat44 pose = iter->PoseAt(alpha);
+			Mat44 model;
+			Mat33 normalMatrix;
+
+			Fl32 depth = -view.transform(pose.getPosition()).z;
+
+			switch (iter->geometry.getType())
+			{
+			case PxGeometryType::eBOX:
+				ScaledModel(pose, iter->geometry.box().halfExtents, model, normalMatrix);
+				Draw(m_cube, model, normalMatrix, iter->color);
+				break;
+			case PxGeometryType::eSPHERE:
+			{
+				Fl32 radius = iter->geometry.sphere().radius;
+				Fl32 pixels = depth > 0.f ? radius * pixelScale / depth : FLT_MAX; // At or behind the eye, draw full detail
+
+				ScaledModel(pose, Vec3(radius), model, normalMatrix);
+				Draw(m_spheres[m_sphereLODs.SelectIndex(pixels)], model, normalMatrix, iter->color);
+				break;
+			}
+			case PxGeometryType::eCONVEXMESH:
+			{
+				const PxConvexMesh* mesh = iter->geometry.convexMesh().convexMesh;
+				const Vec3& scale = iter->geometry.convexMesh().scale.scale; // Shared meshes are scaled per shape
+
+				std::map<const PxConvexMesh*, PxConvexMesh*>::const_iterator hull = simplifiedHulls.find(mesh);
+				if (hull != simplifiedHulls.end() && depth > 0.f &&
+					mesh->getLocalBounds().getExtents().multiply(scale).magnitude() * pixelScale / depth < HULL_LOD_PIXELS)
+					mesh = hull->second;
+
+				ScaledModel(pose, scale, model, normalMatrix);
+				Draw(ConvexMesh(mesh), model, normalMatrix, iter->color);
+				break;
+			}
+			default:
+				break; // Planes and capsules aren't drawn, as with the fixed function path
+			}
+		}
+
+		// Leave the state as the fixed function HUD and menus expect it
+		BindVertexArray(0);
+		UseProgram(0);
+	}
+
+	bool CoreRenderer::IsReady() const
+	{
+		return m_ready;
+	}
+
+	void CoreRenderer::Release(GpuMesh& mesh)
+	{
+		if (mesh.vao) DeleteVertexArrays(1, &mesh.vao);
+		if (mesh.vbo) DeleteBuffers(1, &mesh.vbo);
+		if (mesh.ibo) DeleteBuffers(1, &mesh.ibo);
+		mesh = GpuMesh();
+	}
+
+	void CoreRenderer::Shutdown()
+	{
+		if (!m_ready)
+			return;
+
+		Release(m_cube);
+		for (int i = 0; i < SPHERE_LOD_COUNT; i++)
+			Release(m_spheres[i]);
+		for (std::map<const PxConvexMesh*, GpuMesh>::iterator iter = m_convexMeshes.begin(); iter != m_convexMeshes.end(); iter++)
+			Release(iter->second);
+		m_convexMeshes.clear();
+
+		DeleteBuffers(1, &m_frameUniforms);
+		DeleteProgram(m_program);
+		m_frameUniforms = 0;
+		m_program = 0;
+		m_ready = false;
+	}
+}
@@ -0,0 +1,51 @@
+/*-------------------------------------------------------------------------\
+| File: FILEUTIL.CPP														|
+| Desc: Provides definitions for file helpers shared by the caches and		|
+|		build steps that write their own files.								|
+| Declaration File: FILEUTIL.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "fileUtil.h"
+#include <Windows.h>
+
+namespace GameFramework
+{
+	unsigned long long ModifiedTime(const std::string& path)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes))
+			return 0;
+		return ((unsigned long long)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+	}
+
+	AtomicFile::AtomicFile(const std::string& path) : m_path(path), m_temporary(path + ".tmp"),
+		m_stream(m_temporary.c_str(), std::ios::binary), m_committed(false)
+	{
+	}
+
+	AtomicFile::~AtomicFile()
+	{
+		if (!m_committed && m_stream.is_open())
+		{
+			m_stream.close();
+			DeleteFileA(m_temporary.c_str());
+		}
+	}
+
+	bool AtomicFile::Commit()
+	{
+		if (!m_stream.is_open())
+			return false;
+
+		bool written = m_stream.good();
+		m_stream.close();
+		m_committed = true;
+
+		if (!written || m_stream.fail() || !MoveFileExA(m_temporary.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING))
+		{
+			DeleteFileA(m_temporary.c_str());
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,401 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMECAPTURE.CPP													|
+| Desc: Provides definitions for an asynchronous frame recorder, reading	|
+|		frames back through a ring of pixel buffer objects and writing		|
+|		them out on a background thread.									|
+| Declaration File: FRAMECAPTURE.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "frameCapture.h"
+#include "log.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+namespace GameFramework
+{
+	using namespace GLCore;
+
+	// Longest the GL thread waits on a frame's fence before giving up on it (nanoseconds)
+	static const GLuint64 FENCE_TIMEOUT = 1000000000ull;
+
+	/*-------------------------------------------------------------------------\
+	|							PNG ENCODING									|
+	\-------------------------------------------------------------------------*/
+	// PNG's CRC-32 lookup table, built before main
+	struct CrcTable
+	{
+		unsigned int entries[256];
+
+		CrcTable()
+		{
+			for (unsigned int n = 0; n < 256; n++)
+			{
+				unsigned int c = n;
+				for (int k = 0; k < 8; k++)
+					c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				entries[n] = c;
+			}
+		}
+	};
+	static const CrcTable gCrcTable;
+
+	static unsigned int Crc(unsigned int crc, const unsigned char* data, size_t length)
+	{
+		for (size_t i = 0; i < length; i++)
+			crc = gCrcTable.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return crc;
+	}
+
+	static void PutBE32(std::vector<unsigned char>& out, unsigned int v)
+	{
+		out.push_back((unsigned char)(v >> 24));
+		out.push_back((unsigned char)(v >> 16));
+		out.push_back((unsigned char)(v >> 8));
+		out.push_back((unsigned char)v);
+	}
+
+	static void WriteChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data)
+	{
+		std::vector<unsigned char> chunk;
+		PutBE32(chunk, data.size());
+		chunk.insert(chunk.end(), type, type + 4);
+		chunk.insert(chunk.end(), data.begin(), data.end());
+		PutBE32(chunk, Crc(0xFFFFFFFFu, &chunk[4], chunk.size() - 4) ^ 0xFFFFFFFFu);
+		file.write((const char*)&chunk[0], chunk.size());
+	}
+
+	// Writes an 8 bit RGB PNG from bottom up BGRA pixels. The image data is stored (not deflated) - the writer thread
+	// keeps up with the frame rate this way, and the sequence is expected to be re-encoded to video anyway.
+	static bool WritePNG(const std::string& path, const unsigned char* bgra, int width, int height)
+	{
+		std::ofstream file(path.c_str(), std::ios::binary);
+		if (!file)
+			return false;
+
+		static const unsigned char SIGNATURE[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+		file.write((const char*)SIGNATURE, 8);
+
+		std::vector<unsigned char> header;
+		PutBE32(header, width);
+		PutBE32(header, height);
+		const unsigned char format[5] = { 8, 2, 0, 0, 0 }; // Bit depth, RGB, deflate, adaptive filtering, not interlaced
+		header.insert(header.end(), format, format + 5);
+		WriteChunk(file, "IHDR", header);
+
+		// Scanlines top down, each led by filter type 0 (none)
+		const size_t rowBytes = width * 3 + 1;
+		std::vector<unsigned char> raw(rowBytes * height);
+		for (int y = 0; y < height; y++)
+		{
+			unsigned char* dst = &raw[y * rowBytes];
+			const unsigned char* src = bgra + (size_t)(height - 1 - y) * width * 4;
+			*dst++ = 0;
+			for (int x = 0; x < width; x++, src += 4)
+			{
+				*dst++ = src[2];
+				*dst++ = src[1];
+				*dst++ = src[0];
+			}
+		}
+
+		// zlib stream of stored deflate blocks
+		std::vector<unsigned char> idat;
+		idat.push_back(0x78);
+		idat.push_back(0x01);
+		unsigned int a = 1, b = 0;
+		for (size_t offset = 0; offset < raw.size();)
+		{
+			size_t length = std::min(raw.size() - offset, (size_t)0xFFFF);
+			idat.push_back(offset + length == raw.size() ? 1 : 0);
+			idat.push_back((unsigned char)length);
+			idat.push_back((unsigned char)(length >> 8));
+			idat.push_back((unsigned char)~length);
+			idat.push_back((unsigned char)(~length >> 8));
+			idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + length);
+
+			for (size_t i = offset; i < offset + length; i++)
+			{
+				a = (a + raw[i]) % 65521;
+				b = (b + a) % 65521;
+			}
+			offset += length;
+		}
+		PutBE32(idat, (b << 16) | a);
+		WriteChunk(file, "IDAT", idat);
+
+		WriteChunk(file, "IEND", std::vector<unsigned char>());
+		return file.good();
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							FRAME CAPTURE DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	FrameCapture::FrameCapture()
+		: m_framesWritten(0)
+	{
+		m_capturing = false;
+		m_format = CaptureFormat::PNG;
+		m_width = m_height = 0;
+		m_lossless = false;
+		m_usePBOs = false;
+		m_framesRead = 0;
+		m_framesDropped = 0;
+		m_stopping = false;
+		for (int i = 0; i < CAPTURE_RING_SIZE; i++)
+		{
+			m_pbos[i] = 0;
+			m_fences[i] = NULL;
+			m_frameNumbers[i] = 0;
+		}
+	}
+
+	FrameCapture::~FrameCapture()
+	{
+		// Stop needs the GL context, so it is the owner's job - only make sure the writer isn't left running
+		if (m_writer.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stopping = true;
+			}
+			m_frameQueued.notify_all();
+			m_writer.join();
+		}
+	}
+
+	bool FrameCapture::Start(const std::string& directory, CaptureFormat format, int width, int height, bool lossless)
+	{
+		if (m_capturing)
+			return true;
+
+		if (!CreateDirectoryA(directory.c_str(), NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+		{
+			Log::Write(("Could not create capture directory " + directory + "\n").c_str(), ENGINE_LOG);
+			return false;
+		}
+
+		m_directory = directory;
+		m_format = format;
+		m_width = width;
+		m_height = height;
+		m_lossless = lossless;
+		m_framesRead = 0;
+		m_framesWritten = 0;
+		m_framesDropped = 0;
+		m_stopping = false;
+
+		if (m_format == CaptureFormat::Raw)
+		{
+			m_rawFile.open((m_directory + "\\frames.raw").c_str(), std::ios::binary);
+			if (!m_rawFile)
+			{
+				Log::Write("Could not open the raw capture file!\n", ENGINE_LOG);
+				return false;
+			}
+		}
+
+		m_usePBOs = GLCore::Load();
+		if (m_usePBOs)
+		{
+			GenBuffers(CAPTURE_RING_SIZE, m_pbos);
+			for (int i = 0; i < CAPTURE_RING_SIZE; i++)
+			{
+				BindBuffer(PIXEL_PACK_BUFFER, m_pbos[i]);
+				BufferData(PIXEL_PACK_BUFFER, m_width * m_height * 4, NULL, STREAM_READ);
+				m_fences[i] = NULL;
+			}
+			BindBuffer(PIXEL_PACK_BUFFER, 0);
+		}
+		else
+			Log::Write("Exc: Pixel buffer objects unavailable, frames will be captured synchronously\n", ENGINE_LOG);
+
+		m_writer = std::thread(&FrameCapture::WriterLoop, this);
+		m_capturing = true;
+
+		Log::Write(("Capturing frames to " + m_directory + "\n").c_str(), ENGINE_LOG);
+		return true;
+	}
+
+	void FrameCapture::Capture()
+	{
+		if (!m_capturing)
+			return;
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+		if (!m_usePBOs)
+		{
+			std::vector<unsigned char> pixels = AcquireBuffer();
+			glReadPixels(0, 0, m_width, m_height, BGRA, GL_UNSIGNED_BYTE, &pixels[0]);
+			Submit(m_framesRead++, pixels);
+			return;
+		}
+
+		// The slot still holds the frame read CAPTURE_RING_SIZE frames ago, which has to be collected before reuse
+		int slot = m_framesRead % CAPTURE_RING_SIZE;
+		if (m_fences[slot] != NULL)
+			Collect(slot);
+
+		// Reads into the bound pack buffer return immediately, the copy happens as the GPU gets to it
+		BindBuffer(PIXEL_PACK_BUFFER, m_pbos[slot]);
+		glReadPixels(0, 0, m_width, m_height, BGRA, GL_UNSIGNED_BYTE, NULL);
+		BindBuffer(PIXEL_PACK_BUFFER, 0);
+
+		m_fences[slot] = FenceSync(SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_frameNumbers[slot] = m_framesRead++;
+	}
+
+	void FrameCapture::Collect(int slot)
+	{
+		GLenum result = ClientWaitSync(m_fences[slot], SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+		DeleteSync(m_fences[slot]);
+		m_fences[slot] = NULL;
+
+		if (result != ALREADY_SIGNALED && result != CONDITION_SATISFIED)
+		{
+			Log::Write("Exc: Timed out waiting for a captured frame, it was skipped\n", ENGINE_LOG);
+			return;
+		}
+
+		BindBuffer(PIXEL_PACK_BUFFER, m_pbos[slot]);
+		const void* mapped = MapBufferRange(PIXEL_PACK_BUFFER, 0, m_width * m_height * 4, MAP_READ_BIT);
+		if (mapped != NULL)
+		{
+			std::vector<unsigned char> pixels = AcquireBuffer();
+			memcpy(&pixels[0], mapped, pixels.size());
+			UnmapBuffer(PIXEL_PACK_BUFFER);
+			Submit(m_frameNumbers[slot], pixels);
+		}
+		BindBuffer(PIXEL_PACK_BUFFER, 0);
+	}
+
+	std::vector<unsigned char> FrameCapture::AcquireBuffer()
+	{
+		std::vector<unsigned char> pixels;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_freeBuffers.empty())
+			{
+				pixels.swap(m_freeBuffers.back());
+				m_freeBuffers.pop_back();
+			}
+		}
+		pixels.resize(m_width * m_height * 4);
+		return pixels;
+	}
+
+	void FrameCapture::Submit(unsigned int number, std::vector<unsigned char>& pixels)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		if (m_queue.size() >= CAPTURE_QUEUE_LIMIT)
+		{
+			if (!m_lossless)
+			{
+				m_framesDropped++;
+				m_freeBuffers.push_back(std::vector<unsigned char>());
+				m_freeBuffers.back().swap(pixels);
+				return;
+			}
+
+			while (m_queue.size() >= CAPTURE_QUEUE_LIMIT)
+				m_frameWritten.wait(lock);
+		}
+
+		m_queue.push_back(CapturedFrame());
+		m_queue.back().number = number;
+		m_queue.back().pixels.swap(pixels);
+		lock.unlock();
+
+		m_frameQueued.notify_one();
+	}
+
+	void FrameCapture::WriterLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;)
+		{
+			while (m_queue.empty() && !m_stopping)
+				m_frameQueued.wait(lock);
+
+			// Finish the queue before stopping
+			if (m_queue.empty())
+				break;
+
+			CapturedFrame frame;
+			frame.number = m_queue.front().number;
+			frame.pixels.swap(m_queue.front().pixels);
+			m_queue.pop_front();
+			lock.unlock();
+
+			Write(frame);
+			m_framesWritten++;
+
+			lock.lock();
+			m_freeBuffers.push_back(std::vector<unsigned char>());
+			m_freeBuffers.back().swap(frame.pixels);
+			m_frameWritten.notify_one();
+		}
+	}
+
+	void FrameCapture::Write(const CapturedFrame& frame)
+	{
+		if (m_format == CaptureFormat::Raw)
+		{
+			// Rows top down, as video encoders expect
+			const size_t rowBytes = m_width * 4;
+			for (int y = m_height - 1; y >= 0; y--)
+				m_rawFile.write((const char*)&frame.pixels[y * rowBytes], rowBytes);
+			return;
+		}
+
+		char name[32];
+		sprintf_s(name, "\\frame_%06u.png", frame.number);
+		if (!WritePNG(m_directory + name, &frame.pixels[0], m_width, m_height))
+			Log::Write(("Exc: Could not write captured frame " + m_directory + name + "\n").c_str(), ENGINE_LOG);
+	}
+
+	void FrameCapture::Stop()
+	{
+		if (!m_capturing)
+			return;
+
+		if (m_usePBOs)
+		{
+			// Collect what is still in flight, oldest first
+			for (unsigned int i = 0; i < CAPTURE_RING_SIZE; i++)
+			{
+				int slot = (m_framesRead + i) % CAPTURE_RING_SIZE;
+				if (m_fences[slot] != NULL)
+					Collect(slot);
+			}
+			DeleteBuffers(CAPTURE_RING_SIZE, m_pbos);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_frameQueued.notify_all();
+		m_writer.join();
+
+		if (m_rawFile.is_open())
+			m_rawFile.close();
+		m_freeBuffers.clear();
+		m_capturing = false;
+
+		std::string report = "Captured " + std::to_string(m_framesWritten.load()) + " frames (" +
+			std::to_string(m_framesDropped) + " dropped) to " + m_directory + "\n";
+		if (m_format == CaptureFormat::Raw)
+			report += "\tRaw frames are " + std::to_string(m_width) + "x" + std::to_string(m_height) +
+				" BGRA, e.g. ffmpeg -f rawvideo -pixel_format bgra -video_size " +
+				std::to_string(m_width) + "x" + std::to_string(m_height) + " -i frames.raw capture.mp4\n";
+		Log::Write(report.c_str(), ENGINE_LOG);
+	}
+
+	bool FrameCapture::IsCapturing() const
+	{
+		return m_capturing;
+	}
+}
@@ -0,0 +1,106 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMECLOCK.CPP														|
+| Desc: Provides definitions for a wall clock frame timer and a frame		|
+|		pacer, used to limit the frame rate without spinning.				|
+| Declaration File: FRAMECLOCK.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "frameClock.h"
+#include <thread>
+
+namespace GameFramework
+{
+	// Below this much time to the deadline the pacer yields rather than sleeps, as sleeps can overshoot
+	static const std::chrono::microseconds YIELD_THRESHOLD(2000);
+
+	/*-------------------------------------------------------------------------\
+	|							FRAME CLOCK DEFINITIONS							|
+	\-------------------------------------------------------------------------*/
+	FrameClock::FrameClock()
+	{
+		Reset();
+	}
+
+	FrameClock::~FrameClock()
+	{
+
+	}
+
+	void FrameClock::Reset()
+	{
+		m_last = FrameClockType::now();
+	}
+
+	double FrameClock::Tick()
+	{
+		FrameClockType::time_point now = FrameClockType::now();
+		double seconds = std::chrono::duration<double>(now - m_last).count();
+		m_last = now;
+		return seconds;
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							FRAME PACER DEFINITIONS							|
+	\-------------------------------------------------------------------------*/
+	FramePacer::FramePacer(double targetRate)
+	{
+		m_targetRate = targetRate;
+		m_refreshRate = 0;
+		m_vsync = false;
+	}
+
+	FramePacer::~FramePacer()
+	{
+
+	}
+
+	void FramePacer::SetTargetRate(double targetRate)
+	{
+		m_targetRate = targetRate;
+		m_nextDeadline = FrameClockType::time_point();
+	}
+
+	double FramePacer::TargetRate() const
+	{
+		return m_targetRate;
+	}
+
+	void FramePacer::SetVSync(bool enabled, double refreshRate)
+	{
+		m_vsync = enabled;
+		m_refreshRate = refreshRate;
+	}
+
+	bool FramePacer::VSync() const
+	{
+		return m_vsync;
+	}
+
+	void FramePacer::Wait()
+	{
+		if (m_targetRate <= 0)
+			return;
+
+		// The swap already blocks until the next refresh
+		if (m_vsync && m_refreshRate > 0 && m_targetRate >= m_refreshRate)
+			return;
+
+		const FrameClockType::duration period = std::chrono::duration_cast<FrameClockType::duration>(std::chrono::duration<double>(1.0 / m_targetRate));
+		FrameClockType::time_point now = FrameClockType::now();
+
+		// First frame, or more than a frame behind - restart from now rather than rushing to catch up
+		if (m_nextDeadline == FrameClockType::time_point() || now - m_nextDeadline > period)
+			m_nextDeadline = now;
+
+		while (now < m_nextDeadline)
+		{
+			if (m_nextDeadline - now > YIELD_THRESHOLD)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			else
+				std::this_thread::yield();
+			now = FrameClockType::now();
+		}
+
+		m_nextDeadline += period;
+	}
+}
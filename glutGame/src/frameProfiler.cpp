@@ -0,0 +1,229 @@
+/*-------------------------------------------------------------------------\
+| File: FRAMEPROFILER.CPP													|
+| Desc: Provides definitions for a per phase frame profiler, recording		|
+|		frame timings into a ring buffer and reporting percentiles.			|
+| Declaration File: FRAMEPROFILER.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "frameProfiler.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+namespace GameFramework
+{
+	static const int PHASE_COUNT = (int)ProfilePhase::Count;
+
+	// Graph colors, one per phase
+	static const GLfloat PHASE_COLORS[PHASE_COUNT][3] =
+	{
+		{ 1.f, 1.f, 1.f }, // Input
+		{ 0.f, .8f, 0.f }, // Logic
+		{ 1.f, .5f, 0.f }, // Physics
+		{ .2f, .4f, 1.f }, // Scene
+		{ 1.f, 1.f, 0.f }, // HUD
+		{ .8f, 0.f, .8f }  // Swap
+	};
+
+	static Fl32 Milliseconds(FrameClockType::duration d)
+	{
+		return std::chrono::duration<Fl32, std::milli>(d).count();
+	}
+
+	// Nearest rank percentile of sorted values
+	static Fl32 Percentile(const std::vector<Fl32>& sorted, Fl32 p)
+	{
+		return sorted[(size_t)(p * (sorted.size() - 1) + .5f)];
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							FRAME PROFILER DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	FrameProfiler::FrameProfiler()
+		: m_framesWritten(0)
+	{
+		for (int i = 0; i < PHASE_COUNT; i++)
+			m_current[i] = 0;
+		m_frameStarted = false;
+	}
+
+	FrameProfiler::~FrameProfiler()
+	{
+
+	}
+
+	void FrameProfiler::Add(ProfilePhase phase, Fl32 milliseconds)
+	{
+		m_current[(int)phase] += milliseconds;
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		FrameClockType::time_point now = FrameClockType::now();
+
+		// The first call only marks where the first whole frame begins
+		if (m_frameStarted)
+		{
+			unsigned int written = m_framesWritten.load(std::memory_order_relaxed);
+			FrameSample& sample = m_samples[written % PROFILE_HISTORY];
+			for (int i = 0; i < PHASE_COUNT; i++)
+				sample.phase[i] = m_current[i];
+			sample.frame = Milliseconds(now - m_frameStart);
+
+			// Publish the sample only once it is complete
+			m_framesWritten.store(written + 1, std::memory_order_release);
+		}
+
+		for (int i = 0; i < PHASE_COUNT; i++)
+			m_current[i] = 0;
+		m_frameStart = now;
+		m_frameStarted = true;
+	}
+
+	unsigned int FrameProfiler::Snapshot(std::vector<FrameSample>& samples) const
+	{
+		unsigned int written = m_framesWritten.load(std::memory_order_acquire);
+		unsigned int count = std::min(written, (unsigned int)PROFILE_HISTORY);
+		unsigned int first = written - count;
+
+		samples.resize(count);
+		for (unsigned int i = 0; i < count; i++)
+			samples[i] = m_samples[(first + i) % PROFILE_HISTORY];
+
+		// Drop any frames the writer may have overwritten while they were copied (including one mid write)
+		unsigned int writtenAfter = m_framesWritten.load(std::memory_order_acquire);
+		if (writtenAfter + 1 > first + PROFILE_HISTORY)
+		{
+			unsigned int stale = std::min(writtenAfter + 1 - PROFILE_HISTORY - first, count);
+			samples.erase(samples.begin(), samples.begin() + stale);
+		}
+
+		return samples.size();
+	}
+
+	std::string FrameProfiler::Report() const
+	{
+		std::vector<FrameSample> samples;
+		Snapshot(samples);
+
+		std::stringstream ss;
+		ss << "Frame profile over the last " << samples.size() << " frames\n";
+		if (samples.empty())
+			return ss.str();
+
+		ss << "Phase, p50 (ms), p95 (ms), p99 (ms), Max (ms)\n";
+		ss << std::fixed << std::setprecision(3);
+
+		std::vector<Fl32> values(samples.size());
+		for (int i = 0; i <= PHASE_COUNT; i++)
+		{
+			// The final row covers whole frames
+			for (size_t j = 0; j < samples.size(); j++)
+				values[j] = i < PHASE_COUNT ? samples[j].phase[i] : samples[j].frame;
+			std::sort(values.begin(), values.end());
+
+			ss << (i < PHASE_COUNT ? PhaseName((ProfilePhase)i) : "Frame") << ", "
+				<< Percentile(values, .5f) << ", "
+				<< Percentile(values, .95f) << ", "
+				<< Percentile(values, .99f) << ", "
+				<< values.back() << "\n";
+		}
+
+		return ss.str();
+	}
+
+	void FrameProfiler::RenderGraph(Fl32 budgetMs)
+	{
+		std::vector<FrameSample> samples;
+		Snapshot(samples);
+
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+
+		// One pixel column per frame, newest on the right
+		unsigned int columns = std::min((unsigned int)samples.size(), (unsigned int)viewport[2]);
+		const Fl32 scale = PROFILE_GRAPH_HEIGHT / PROFILE_GRAPH_MAX_MS;
+
+		m_graph.clear();
+		for (unsigned int i = 0; i < columns; i++)
+		{
+			const FrameSample& sample = samples[samples.size() - columns + i];
+			GLfloat x = (GLfloat)(viewport[2] - columns + i) + .5f;
+			GLfloat y = 0.f;
+
+			for (int p = 0; p < PHASE_COUNT; p++)
+			{
+				GLfloat top = std::min(y + sample.phase[p] * scale, (GLfloat)PROFILE_GRAPH_HEIGHT);
+				const GLfloat* c = PHASE_COLORS[p];
+				GraphVertex line[2] =
+				{
+					{ c[0], c[1], c[2], x, y,   0.f },
+					{ c[0], c[1], c[2], x, top, 0.f }
+				};
+				m_graph.insert(m_graph.end(), line, line + 2);
+				y = top;
+			}
+		}
+
+		// Frame budget marker
+		GLfloat budgetY = std::min(budgetMs * scale, (GLfloat)PROFILE_GRAPH_HEIGHT);
+		GraphVertex budget[2] =
+		{
+			{ 1.f, 0.f, 0.f, 0.f,				 budgetY, 0.f },
+			{ 1.f, 0.f, 0.f, (GLfloat)viewport[2], budgetY, 0.f }
+		};
+		m_graph.insert(m_graph.end(), budget, budget + 2);
+
+		glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+		glDisable(GL_LIGHTING);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_TEXTURE_2D);
+
+		glMatrixMode(GL_PROJECTION);
+			glPushMatrix();
+			glLoadIdentity();
+			gluOrtho2D(0.0, viewport[2], 0.0, viewport[3]);
+		glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+
+			glInterleavedArrays(GL_C3F_V3F, 0, &m_graph[0]);
+			glDrawArrays(GL_LINES, 0, m_graph.size());
+			glDisableClientState(GL_COLOR_ARRAY);
+			glDisableClientState(GL_VERTEX_ARRAY);
+
+		glMatrixMode(GL_PROJECTION);
+			glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+			glPopMatrix();
+		glPopAttrib();
+	}
+
+	const char* FrameProfiler::PhaseName(ProfilePhase phase)
+	{
+		switch (phase)
+		{
+		case ProfilePhase::Input:	return "Input";
+		case ProfilePhase::Logic:	return "Logic";
+		case ProfilePhase::Physics: return "Physics";
+		case ProfilePhase::Scene:	return "Scene";
+		case ProfilePhase::HUD:		return "HUD";
+		case ProfilePhase::Swap:	return "Swap";
+		default:					return "Unknown";
+		}
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							PROFILE SCOPE DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	ProfileScope::ProfileScope(FrameProfiler& profiler, ProfilePhase phase)
+		: m_profiler(profiler), m_phase(phase)
+	{
+		m_start = FrameClockType::now();
+	}
+
+	ProfileScope::~ProfileScope()
+	{
+		m_profiler.Add(m_phase, Milliseconds(FrameClockType::now() - m_start));
+	}
+}
@@ -0,0 +1,47 @@
+/*-------------------------------------------------------------------------\
+| File: FRUSTUM.CPP															|
+| Desc: Provides definitions for a view frustum, used to cull geometry		|
+|		outside the camera's view.											|
+| Declaration File: FRUSTUM.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "frustum.h"
+
+using namespace physx;
+
+namespace GameFramework
+{
+	Frustum::Frustum()
+	{
+		// Planes at infinity, nothing is culled until the frustum is set
+		for (int i = 0; i < (int)FrustumPlane::Count; i++)
+			m_planes[i] = PxPlane(Vec3(0, 1, 0), PX_MAX_F32);
+	}
+
+	Frustum::~Frustum()
+	{
+
+	}
+
+	void Frustum::SetPlane(FrustumPlane plane, const PxPlane& value)
+	{
+		m_planes[(int)plane] = value;
+	}
+
+	bool Frustum::Intersects(const PxBounds3& bounds) const
+	{
+		for (int i = 0; i < (int)FrustumPlane::Count; i++)
+		{
+			const PxPlane& p = m_planes[i];
+
+			// Corner of the box furthest along the plane normal
+			Vec3 corner(p.n.x >= 0 ? bounds.maximum.x : bounds.minimum.x,
+						p.n.y >= 0 ? bounds.maximum.y : bounds.minimum.y,
+						p.n.z >= 0 ? bounds.maximum.z : bounds.minimum.z);
+
+			if (p.distance(corner) < 0)
+				return false;
+		}
+		return true;
+	}
+}
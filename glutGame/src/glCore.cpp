@@ -0,0 +1,134 @@
+/*-------------------------------------------------------------------------\
+| File: GLCORE.CPP															|
+| Desc: Provides definitions for the OpenGL 1.5 - 3.3 entry points and		|
+|		tokens not exported by opengl32.lib, loaded at runtime.				|
+| Declaration File: GLCORE.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "glCore.h"
+#include "log.h"
+#include <cstdio>
+#include <string>
+
+namespace GameFramework
+{
+	namespace GLCore
+	{
+		void (WINAPI *GenBuffers)(GLsizei, GLuint*) = NULL;
+		void (WINAPI *DeleteBuffers)(GLsizei, const GLuint*) = NULL;
+		void (WINAPI *BindBuffer)(GLenum, GLuint) = NULL;
+		void (WINAPI *BindBufferBase)(GLenum, GLuint, GLuint) = NULL;
+		void (WINAPI *BufferData)(GLenum, GLsizeiptr, const void*, GLenum) = NULL;
+		void (WINAPI *BufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*) = NULL;
+		void* (WINAPI *MapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield) = NULL;
+		GLboolean (WINAPI *UnmapBuffer)(GLenum) = NULL;
+
+		void (WINAPI *GenVertexArrays)(GLsizei, GLuint*) = NULL;
+		void (WINAPI *DeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+		void (WINAPI *BindVertexArray)(GLuint) = NULL;
+		void (WINAPI *VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = NULL;
+		void (WINAPI *EnableVertexAttribArray)(GLuint) = NULL;
+
+		GLuint (WINAPI *CreateShader)(GLenum) = NULL;
+		void (WINAPI *DeleteShader)(GLuint) = NULL;
+		void (WINAPI *ShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = NULL;
+		void (WINAPI *CompileShader)(GLuint) = NULL;
+		void (WINAPI *GetShaderiv)(GLuint, GLenum, GLint*) = NULL;
+		void (WINAPI *GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+		GLuint (WINAPI *CreateProgram)() = NULL;
+		void (WINAPI *DeleteProgram)(GLuint) = NULL;
+		void (WINAPI *AttachShader)(GLuint, GLuint) = NULL;
+		void (WINAPI *LinkProgram)(GLuint) = NULL;
+		void (WINAPI *GetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+		void (WINAPI *GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+		void (WINAPI *UseProgram)(GLuint) = NULL;
+		GLint (WINAPI *GetUniformLocation)(GLuint, const GLchar*) = NULL;
+		GLuint (WINAPI *GetUniformBlockIndex)(GLuint, const GLchar*) = NULL;
+		void (WINAPI *UniformBlockBinding)(GLuint, GLuint, GLuint) = NULL;
+		void (WINAPI *Uniform3fv)(GLint, GLsizei, const GLfloat*) = NULL;
+		void (WINAPI *UniformMatrix3fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+		void (WINAPI *UniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+
+		GLsync (WINAPI *FenceSync)(GLenum, GLbitfield) = NULL;
+		void (WINAPI *DeleteSync)(GLsync) = NULL;
+		GLenum (WINAPI *ClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+		static bool loaded = false;
+
+		// Looks up name, storing it in entry. Returns false (and logs) if the driver doesn't provide it.
+		template <typename T>
+		static bool LoadEntry(T& entry, const char* name)
+		{
+			entry = (T)wglGetProcAddress(name);
+			if (entry == NULL)
+			{
+				std::string s = std::string("\tMissing GL entry point ") + name + "\n";
+				Log::Write(s.c_str(), ENGINE_LOG);
+				return false;
+			}
+			return true;
+		}
+
+		bool Load()
+		{
+			if (loaded)
+				return true;
+
+			const char* version = (const char*)glGetString(GL_VERSION);
+			int major = 0, minor = 0;
+			if (version == NULL || sscanf(version, "%d.%d", &major, &minor) != 2 || major < 3 || (major == 3 && minor < 3))
+			{
+				Log::Write("GL 3.3 is not supported by this context!\n", ENGINE_LOG);
+				return false;
+			}
+
+			bool ok = true;
+			ok &= LoadEntry(GenBuffers, "glGenBuffers");
+			ok &= LoadEntry(DeleteBuffers, "glDeleteBuffers");
+			ok &= LoadEntry(BindBuffer, "glBindBuffer");
+			ok &= LoadEntry(BindBufferBase, "glBindBufferBase");
+			ok &= LoadEntry(BufferData, "glBufferData");
+			ok &= LoadEntry(BufferSubData, "glBufferSubData");
+			ok &= LoadEntry(MapBufferRange, "glMapBufferRange");
+			ok &= LoadEntry(UnmapBuffer, "glUnmapBuffer");
+
+			ok &= LoadEntry(GenVertexArrays, "glGenVertexArrays");
+			ok &= LoadEntry(DeleteVertexArrays, "glDeleteVertexArrays");
+			ok &= LoadEntry(BindVertexArray, "glBindVertexArray");
+			ok &= LoadEntry(VertexAttribPointer, "glVertexAttribPointer");
+			ok &= LoadEntry(EnableVertexAttribArray, "glEnableVertexAttribArray");
+
+			ok &= LoadEntry(CreateShader, "glCreateShader");
+			ok &= LoadEntry(DeleteShader, "glDeleteShader");
+			ok &= LoadEntry(ShaderSource, "glShaderSource");
+			ok &= LoadEntry(CompileShader, "glCompileShader");
+			ok &= LoadEntry(GetShaderiv, "glGetShaderiv");
+			ok &= LoadEntry(GetShaderInfoLog, "glGetShaderInfoLog");
+			ok &= LoadEntry(CreateProgram, "glCreateProgram");
+			ok &= LoadEntry(DeleteProgram, "glDeleteProgram");
+			ok &= LoadEntry(AttachShader, "glAttachShader");
+			ok &= LoadEntry(LinkProgram, "glLinkProgram");
+			ok &= LoadEntry(GetProgramiv, "glGetProgramiv");
+			ok &= LoadEntry(GetProgramInfoLog, "glGetProgramInfoLog");
+			ok &= LoadEntry(UseProgram, "glUseProgram");
+			ok &= LoadEntry(GetUniformLocation, "glGetUniformLocation");
+			ok &= LoadEntry(GetUniformBlockIndex, "glGetUniformBlockIndex");
+			ok &= LoadEntry(UniformBlockBinding, "glUniformBlockBinding");
+			ok &= LoadEntry(Uniform3fv, "glUniform3fv");
+			ok &= LoadEntry(UniformMatrix3fv, "glUniformMatrix3fv");
+			ok &= LoadEntry(UniformMatrix4fv, "glUniformMatrix4fv");
+
+			ok &= LoadEntry(FenceSync, "glFenceSync");
+			ok &= LoadEntry(DeleteSync, "glDeleteSync");
+			ok &= LoadEntry(ClientWaitSync, "glClientWaitSync");
+
+			loaded = ok;
+			return ok;
+		}
+
+		bool IsLoaded()
+		{
+			return loaded;
+		}
+	}
+}
@@ -5,7 +5,12 @@
 | Author: Henri Keeble														|
 \-------------------------------------------------------------------------*/
 #include "glutGame.h"
+#include <mmsystem.h>
 #include <iostream>
+#include <chrono>
+#include <cfloat>
+#include <ctime>
+#include <fstream>
 
 using namespace physx;
 
@@ -18,12 +23,65 @@ namespace GameFramework
 	static const int MAX_NUM_CONVEXMESH_TRIANGLES = 1024;
 	static unsigned int gConvexMeshTriIndices[3 * MAX_NUM_CONVEXMESH_TRIANGLES];
 
+	// Unit cube (half extents of 1), four vertices per face, laid out for glInterleavedArrays(GL_T2F_N3F_V3F). Every face winds
+	// counter-clockwise seen from outside, so the cube draws correctly with back face culling or two-sided lighting.
+	struct CubeVertex
+	{
+		GLfloat s, t;
+		GLfloat nx, ny, nz;
+		GLfloat x, y, z;
+	};
+
+	static const int CUBE_VERTS = 24;
+	static const CubeVertex gUnitCube[CUBE_VERTS] =
+	{
+		// -X
+		{  0.f,  0.f, -1.f,  0.f,  0.f, -1.f, -1.f, -1.f },
+		{  0.f,  1.f, -1.f,  0.f,  0.f, -1.f, -1.f,  1.f },
+		{  1.f,  1.f, -1.f,  0.f,  0.f, -1.f,  1.f,  1.f },
+		{  1.f,  0.f, -1.f,  0.f,  0.f, -1.f,  1.f, -1.f },
+		// +Y
+		{  0.f,  0.f,  0.f,  1.f,  0.f, -1.f,  1.f, -1.f },
+		{  0.f,  1.f,  0.f,  1.f,  0.f, -1.f,  1.f,  1.f },
+		{  1.f,  1.f,  0.f,  1.f,  0.f,  1.f,  1.f,  1.f },
+		{  1.f,  0.f,  0.f,  1.f,  0.f,  1.f,  1.f, -1.f },
+		// +X
+		{  1.f,  0.f,  1.f,  0.f,  0.f,  1.f,  1.f, -1.f },
+		{  1.f,  1.f,  1.f,  0.f,  0.f,  1.f,  1.f,  1.f },
+		{  0.f,  1.f,  1.f,  0.f,  0.f,  1.f, -1.f,  1.f },
+		{  0.f,  0.f,  1.f,  0.f,  0.f,  1.f, -1.f, -1.f },
+		// -Y
+		{  1.f,  0.f,  0.f, -1.f,  0.f,  1.f, -1.f, -1.f },
+		{  1.f,  1.f,  0.f, -1.f,  0.f,  1.f, -1.f,  1.f },
+		{  0.f,  1.f,  0.f, -1.f,  0.f, -1.f, -1.f,  1.f },
+		{  0.f,  0.f,  0.f, -1.f,  0.f, -1.f, -1.f, -1.f },
+		// +Z
+		{  1.f,  0.f,  0.f,  0.f,  1.f,  1.f, -1.f,  1.f },
+		{  1.f,  1.f,  0.f,  0.f,  1.f,  1.f,  1.f,  1.f },
+		{  0.f,  1.f,  0.f,  0.f,  1.f, -1.f,  1.f,  1.f },
+		{  0.f,  0.f,  0.f,  0.f,  1.f, -1.f, -1.f,  1.f },
+		// -Z
+		{  1.f,  1.f,  0.f,  0.f, -1.f,  1.f,  1.f, -1.f },
+		{  1.f,  0.f,  0.f,  0.f, -1.f,  1.f, -1.f, -1.f },
+		{  0.f,  0.f,  0.f,  0.f, -1.f, -1.f, -1.f, -1.f },
+		{  0.f,  1.f,  0.f,  0.f, -1.f, -1.f,  1.f, -1.f }
+	};
+
 	GLUTGame::GLUTGame(std::string title, int windowWidth, int windowHeight)
+		: m_framePacer(FPS), m_simulationPacer(FPS)
 	{
-		Physics::PxInit(); // initialize physics
+		{
+			// Images and sounds are read from the archive if it is there, and from loose files if not
+			TraceScope scope("AssetArchive");
+			AssetArchive::Open(std::string(GetCurrentDir()) + ASSET_ARCHIVE);
+		}
+		{
+			TraceScope scope("PxInit");
+			Physics::PxInit(); // initialize physics
 
-		m_scene = new Physics::Scene();
-		m_scene->Init(); // initialize scene
+			m_scene = new Physics::Scene();
+			m_scene->Init(); // initialize scene
+		}
 
 		instance = this; // Assign current instance for callback wrapper functions
 
@@ -31,14 +89,31 @@ namespace GameFramework
 		m_windowHeight = windowHeight;
 		m_windowWidth = windowWidth;
 
-		lastElapsedTime = 0;
-		newElapsedTime = 0;
 		deltaTime = 0;
+		m_vsync = false;
+		m_showProfileGraph = false;
+
+		m_threaded = false;
+		m_simulationRunning = false;
+		m_exitRequested = false;
+		m_exitStatus = 0;
+
+		m_sphereLODs.Build();
+		m_renderBackend = RenderBackend::FixedFunction;
+		m_captureWanted = false;
+		m_startupComplete = false;
+		m_captureFormat = (int)CaptureFormat::PNG;
 
 		m_is2D = false;
+		m_offscreen = false;
+		m_audioBackend = AudioBackendType::BASS;
+		m_audioBackendSet = false;
 
-		m_milliSecondsSinceLastFrame = 0;
 		simTimer = 0;
+		m_pxTimeStep = 1.f / FPS;
+		m_interpolate = false;
+
+		m_boundsGeneration = m_scene->Generation();
 
 		m_frame = 0;
 		m_timebase = 0;
@@ -54,31 +129,294 @@ namespace GameFramework
 	{
 		Log::Write("Game Run Function Invoked...\n", ENGINE_LOG);
 
-		InitGLUT(argc, argv);
-		InitGL();
-		InitBASS();
+		{
+			TraceScope scope("InitGLUT");
+			InitGLUT(argc, argv);
+		}
+		{
+			TraceScope scope("InitGL");
+			InitGL();
+			InitRenderer();
+		}
+		{
+			TraceScope scope("InitAudio");
+			InitAudio();
+		}
+		SetVSync(m_vsync);
+
+		// Finer scheduler granularity, so the frame pacer's sleeps land close to their deadline
+		timeBeginPeriod(1);
 
 		Log::Write("Initializing Game...\n", ENGINE_LOG);
-		Init();
+		{
+			TraceScope scope("Init");
+			Init();
+		}
+
+		// Don't count initialization time as the first frame's delta
+		m_frameClock.Reset();
+		m_physicsClock.Reset();
+
+		// Something to draw before the first tick
+		PublishSnapshot();
+
+		if (m_threaded)
+		{
+			Log::Write("Starting simulation thread...\n", ENGINE_LOG);
+			m_simulationRunning = true;
+			m_simulationThread = std::thread(&GLUTGame::SimulationLoop, this);
+		}
 
 		Log::Write("Entering main game loop...\n", ENGINE_LOG);
 		glutMainLoop();
 	}
 
+	void GLUTGame::RunRenderBenchmark(int argc, char *argv[], int frames)
+	{
+		Log::Write("Game Render Benchmark Invoked...\n", ENGINE_LOG);
+
+		if (!InitOffscreen(argc, argv))
+			return;
+		InitGL();
+		InitRenderer();
+		InitAudio();
+
+		Log::Write("Initializing Game...\n", ENGINE_LOG);
+		Init();
+		Reshape(m_windowWidth, m_windowHeight);
+
+		std::string report = "Scene, Frames, Avg (ms), Min (ms), Max (ms)\n";
+
+		for (int scene = 0; scene < BenchmarkSceneCount(); scene++)
+		{
+			std::string name = SetBenchmarkScene(scene);
+			PublishSnapshot();
+			m_snapshots.Acquire();
+			Render(); // Warm up, so first use costs are not measured
+
+			double total = 0, min = DBL_MAX, max = 0;
+			for (int i = 0; i < frames; i++)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				Render();
+				double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				total += ms;
+				if (ms < min) min = ms;
+				if (ms > max) max = ms;
+			}
+
+			if (frames > 0)
+				report += name + ", " + std::to_string(frames) + ", " + std::to_string(total / frames) + ", " +
+					std::to_string(min) + ", " + std::to_string(max) + "\n";
+		}
+
+		Log::Write(report.c_str(), RENDER_BENCH_LOG);
+		Log::Write(report.c_str(), ENGINE_LOG);
+
+		Audio::Shutdown();
+		m_capture.Stop();
+		m_coreRenderer.Shutdown();
+		m_offscreenContext.Release();
+	}
+
+	void GLUTGame::RunStartupProbe(int argc, char *argv[])
+	{
+		Log::Write("Game Startup Probe Invoked...\n", ENGINE_LOG);
+
+		{
+			TraceScope scope("InitOffscreen");
+			if (!InitOffscreen(argc, argv))
+				return;
+		}
+		{
+			TraceScope scope("InitGL");
+			InitGL();
+			InitRenderer();
+		}
+		{
+			TraceScope scope("InitAudio");
+			InitAudio();
+		}
+		{
+			TraceScope scope("Init");
+			Init();
+		}
+		Reshape(m_windowWidth, m_windowHeight);
+
+		PublishSnapshot();
+		m_snapshots.Acquire();
+
+		// Textures may still be arriving from the decoding threads, so render until the game marks its first real frame
+		double deadline = StartupTrace::Elapsed() + STARTUP_PROBE_TIMEOUT;
+		while (StartupTrace::FirstFrame() < 0 && StartupTrace::Elapsed() < deadline)
+			Render();
+
+		double firstFrame = StartupTrace::FirstFrame();
+		if (firstFrame >= 0)
+		{
+			std::ofstream result((std::string(Log::GetWorkingDir()) + STARTUP_PROBE_LOG).c_str());
+			result << firstFrame << "\n";
+		}
+		else
+			Log::Write("Startup probe timed out before the first frame!\n", ENGINE_LOG);
+
+		StartupTrace::Write();
+		TextureManager::Shutdown();
+		Audio::Shutdown();
+		AssetArchive::Close();
+		m_capture.Stop();
+		m_coreRenderer.Shutdown();
+		m_offscreenContext.Release();
+	}
+
 	void GLUTGame::Init()
 	{
 
 	}
 
+	int GLUTGame::BenchmarkSceneCount()
+	{
+		return 1;
+	}
+
+	std::string GLUTGame::SetBenchmarkScene(int scene)
+	{
+		return "Default";
+	}
+
 	void GLUTGame::UpdatePerspective(const Fl32& FOV)
 	{
 		glMatrixMode(GL_PROJECTION);
 		glLoadIdentity();
-		Fl32 r = glutGet(GLUT_INIT_WINDOW_WIDTH) / glutGet(GLUT_INIT_WINDOW_HEIGHT);
-		gluPerspective(FOV, r, .1, 100);
+		gluPerspective(FOV, AspectRatio(), CAMERA_NEAR, CAMERA_FAR);
 		glMatrixMode(GL_MODELVIEW);
 	}
 
+	Fl32 GLUTGame::AspectRatio()
+	{
+		return glutGet(GLUT_INIT_WINDOW_WIDTH) / glutGet(GLUT_INIT_WINDOW_HEIGHT);
+	}
+
+	int GLUTGame::StepPhysics()
+	{
+		Fl32 frameTime = (Fl32)m_physicsClock.Tick();
+
+		// Paused time is never owed to the simulation
+		if (m_scene->IsPaused())
+		{
+			simTimer = 0;
+			return 0;
+		}
+
+		simTimer += frameTime;
+
+		int steps = 0;
+		while (simTimer >= m_pxTimeStep && steps < PHYSICS_MAX_STEPS)
+		{
+			m_scene->UpdatePhys(m_pxTimeStep);
+			simTimer -= m_pxTimeStep;
+			steps++;
+
+			if (m_interpolate)
+				RecordPoses();
+		}
+
+		if (simTimer >= m_pxTimeStep)
+			simTimer = fmodf(simTimer, m_pxTimeStep);
+
+		return steps;
+	}
+
+	void GLUTGame::RecordPoses()
+	{
+		std::vector<PxRigidActor*> actors = m_scene->GetActors(PxActorTypeSelectionFlag::eRIGID_DYNAMIC);
+		for (std::vector<PxRigidActor*>::iterator iter = actors.begin(); iter != actors.end(); iter++)
+		{
+			Transform pose = (*iter)->getGlobalPose();
+
+			std::map<const PxRigidActor*, PoseHistory>::iterator history = m_poseHistory.find(*iter);
+			if (history == m_poseHistory.end())
+			{
+				PoseHistory first = { pose, pose };
+				m_poseHistory.insert(std::make_pair(*iter, first));
+			}
+			else
+			{
+				history->second.previous = history->second.current;
+				history->second.current = pose;
+			}
+		}
+	}
+
+	void GLUTGame::SkipPhysics()
+	{
+		m_physicsClock.Tick();
+		simTimer = 0;
+
+		// Poses from before the skip would be blended with the first ones after it
+		m_poseHistory.clear();
+	}
+
+	void GLUTGame::SetShapePose(ShapeDraw& draw, const PxRigidActor* actor, const Transform& localPose) const
+	{
+		draw.pose = Mat44(actor->getGlobalPose() * localPose);
+		draw.interpolated = false;
+
+		if (m_interpolate && actor->isRigidDynamic())
+		{
+			std::map<const PxRigidActor*, PoseHistory>::const_iterator history = m_poseHistory.find(actor);
+			if (history != m_poseHistory.end())
+			{
+				draw.interpolated = true;
+				draw.previous = history->second.previous;
+				draw.current = history->second.current;
+				draw.local = localPose;
+			}
+		}
+	}
+
+	void GLUTGame::SetRenderInterpolation(bool enabled)
+	{
+		m_interpolate = enabled;
+
+		// Histories restart from the next step
+		m_poseHistory.clear();
+	}
+
+	bool GLUTGame::RenderInterpolation() const
+	{
+		return m_interpolate;
+	}
+
+	void GLUTGame::UpdateFrustum()
+	{
+		m_frustum = camera.GetFrustum(AspectRatio());
+	}
+
+	bool GLUTGame::IsVisible(const PxRigidActor* actor)
+	{
+		if (actor->isRigidStatic())
+		{
+			// A new actor may have been allocated where a released one was
+			if (m_scene->Generation() != m_boundsGeneration)
+				ClearBoundsCache();
+
+			std::map<const PxRigidActor*, PxBounds3>::iterator cached = m_staticBounds.find(actor);
+			if (cached == m_staticBounds.end())
+				cached = m_staticBounds.insert(std::make_pair(actor, actor->getWorldBounds())).first;
+			return m_frustum.Intersects(cached->second);
+		}
+
+		return m_frustum.Intersects(actor->getWorldBounds());
+	}
+
+	void GLUTGame::ClearBoundsCache()
+	{
+		m_staticBounds.clear();
+		m_boundsGeneration = m_scene->Generation();
+	}
+
 	void GLUTGame::InitGL() // Virtual Initialization - Override to change lighting params
 	{
 		Log::Write("Intializing OpenGL (context version ", ENGINE_LOG);
@@ -100,11 +438,40 @@ namespace GameFramework
 		glEnable(GL_LIGHT0);
 	}
 
-	void GLUTGame::InitBASS()
+	void GLUTGame::InitAudio()
+	{
+		// Offscreen runs play nothing, unless asked to (to record what they play, for instance)
+		Audio::Init(m_offscreen && !m_audioBackendSet ? AudioBackendType::Null : m_audioBackend, m_audioConfig);
+	}
+
+	void GLUTGame::SetAudioBackend(AudioBackendType backend)
 	{
-		Log::Write("Initializing BASS...\n", ENGINE_LOG);
-		if (!BASS_Init(-1, 44100, 0, 0, 0))
-			Log::Write("Error initializing BASS!\n", ENGINE_LOG);
+		m_audioBackend = backend;
+		m_audioBackendSet = true;
+	}
+
+	void GLUTGame::SetAudioConfig(const AudioConfig& config)
+	{
+		m_audioConfig = config;
+	}
+
+	void GLUTGame::InitRenderer()
+	{
+		if (m_renderBackend == RenderBackend::Core && !m_coreRenderer.Init())
+		{
+			Log::Write("Exc: Core profile renderer unavailable, falling back to fixed function\n", ENGINE_LOG);
+			m_renderBackend = RenderBackend::FixedFunction;
+		}
+	}
+
+	void GLUTGame::SetRenderBackend(RenderBackend backend)
+	{
+		m_renderBackend = backend;
+	}
+
+	RenderBackend GLUTGame::GetRenderBackend() const
+	{
+		return m_renderBackend;
 	}
 
 	void GLUTGame::InitGLUT(int argc, char *argv[])
@@ -131,118 +498,130 @@ namespace GameFramework
 		atexit(ExitWrapper);
 	}
 
-	void GLUTGame::RenderGeometry(PxGeometryHolder h, bool textured)
+	bool GLUTGame::InitOffscreen(int argc, char *argv[])
+	{
+		Log::Write("Intializing GLUT (offscreen)...\n", ENGINE_LOG);
+
+		m_offscreen = true;
+
+		// GLUT is still used for timing and bitmap fonts, but no window is created
+		glutInit(&argc, argv);
+		glutInitWindowSize(m_windowWidth, m_windowHeight);
+		atexit(ExitWrapper);
+
+		if (!m_offscreenContext.Create(m_windowWidth, m_windowHeight))
+		{
+			Log::Write("Offscreen rendering unavailable!\n", ENGINE_LOG);
+			return false;
+		}
+
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+		return true;
+	}
+
+	void GLUTGame::RenderGeometry(PxGeometryHolder h, Fl32 pixelsPerUnit, bool textured)
 	{
 		switch (h.getType())
 		{
 		case PxGeometryType::eBOX:
 			glScalef(h.box().halfExtents.x, h.box().halfExtents.y, h.box().halfExtents.z);
-			if (textured)
-				RenderTexturedCube(2.0f);
-			else
-				glutSolidCube(2.0f);
+			RenderCube(textured);
 			break;
 		case PxGeometryType::eSPHERE:
-			glutSolidSphere(h.sphere().radius, RENDER_DETAIL, RENDER_DETAIL);
+		{
+			Fl32 radius = h.sphere().radius;
+			const SphereMesh& sphere = m_sphereLODs.Select(radius * pixelsPerUnit);
+
+			glPushAttrib(GL_ENABLE_BIT);
+			glEnable(GL_NORMALIZE); // Unit sphere normals are scaled with it
+			glScalef(radius, radius, radius);
+			sphere.Render();
+			glPopAttrib();
 			break;
+		}
 		case PxGeometryType::eCONVEXMESH:
-			PxConvexMesh* mesh = h.convexMesh().convexMesh;
-			const PxU32 nbPolys = mesh->getNbPolygons();
-			const PxU8* polygons = mesh->getIndexBuffer();
-			const PxVec3* verts = mesh->getVertices();
-			PxU32 numTotalTriangles = 0;
+		{
+			const PxConvexMesh* mesh = h.convexMesh().convexMesh;
 
-			for (PxU32 i = 0; i < nbPolys; i++)
-			{
-				PxHullPolygon data;
-				mesh->getPolygonData(i, data);
+			// Shared meshes are scaled per shape (mesh scales are never rotated here)
+			const Vec3& scale = h.convexMesh().scale.scale;
 
-				const PxU32 nbTris = data.mNbVerts - 2;
-				const PxU8 vref0 = polygons[data.mIndexBase + 0];
-				for (PxU32 j = 0; j < nbTris; j++)
-				{
-					const PxU32 vref1 = polygons[data.mIndexBase + 0 + j + 1];
-					const PxU32 vref2 = polygons[data.mIndexBase + 0 + j + 2];
-					if (numTotalTriangles < MAX_NUM_CONVEXMESH_TRIANGLES)
-					{
-						gConvexMeshTriIndices[3 * numTotalTriangles + 0] = vref0;
-						gConvexMeshTriIndices[3 * numTotalTriangles + 1] = vref1;
-						gConvexMeshTriIndices[3 * numTotalTriangles + 2] = vref2;
-						numTotalTriangles++;
-					}
-				}
-			}
+			// Sized at the shape's scale, picked before it is applied, as the core renderer does
+			std::map<const PxConvexMesh*, PxConvexMesh*>::const_iterator hull = m_simplifiedHulls.find(mesh);
+			if (hull != m_simplifiedHulls.end() && mesh->getLocalBounds().getExtents().multiply(scale).magnitude() * pixelsPerUnit < HULL_LOD_PIXELS)
+				mesh = hull->second;
 
-			if (numTotalTriangles < MAX_NUM_CONVEXMESH_TRIANGLES)
-			{
-				glEnableClientState(GL_VERTEX_ARRAY);
-				glVertexPointer(3, GL_FLOAT, 0, verts);
-				glDrawElements(GL_TRIANGLES, numTotalTriangles * 3, GL_UNSIGNED_INT, gConvexMeshTriIndices);
-				glDisableClientState(GL_VERTEX_ARRAY);
-			}
+			glScalef(scale.x, scale.y, scale.z);
+
+			RenderConvexMesh(mesh);
+			break;
+		}
 		}
 	}
 
-	// Modification of glutSolidCube() with texture coordinates
-	void GLUTGame::RenderTexturedCube(GLint size)
+	void GLUTGame::RenderConvexMesh(const PxConvexMesh* mesh)
 	{
-		static GLfloat n[6][3] =
-		{
-			{ -1.0, 0.0, 0.0 },
-			{ 0.0, 1.0, 0.0 },
-			{ 1.0, 0.0, 0.0 },
-			{ 0.0, -1.0, 0.0 },
-			{ 0.0, 0.0, 1.0 },
-			{ 0.0, 0.0, -1.0 }
-		};
-		static GLint faces[6][4] =
+		const PxU32 nbPolys = mesh->getNbPolygons();
+		const PxU8* polygons = mesh->getIndexBuffer();
+		const PxVec3* verts = mesh->getVertices();
+		PxU32 numTotalTriangles = 0;
+
+		for (PxU32 i = 0; i < nbPolys; i++)
 		{
-			{ 0, 1, 2, 3 },
-			{ 3, 2, 6, 7 },
-			{ 7, 6, 5, 4 },
-			{ 4, 5, 1, 0 },
-			{ 5, 6, 2, 1 },
-			{ 7, 4, 0, 3 }
-		};
-		GLfloat v[8][3];
-		GLfloat t[8][3][2];
-		GLint i;
+			PxHullPolygon data;
+			mesh->getPolygonData(i, data);
 
-		v[0][0] = v[1][0] = v[2][0] = v[3][0] = -size / 2;
-		v[4][0] = v[5][0] = v[6][0] = v[7][0] = size / 2;
-		v[0][1] = v[1][1] = v[4][1] = v[5][1] = -size / 2;
-		v[2][1] = v[3][1] = v[6][1] = v[7][1] = size / 2;
-		v[0][2] = v[3][2] = v[4][2] = v[7][2] = -size / 2;
-		v[1][2] = v[2][2] = v[5][2] = v[6][2] = size / 2;
+			const PxU32 nbTris = data.mNbVerts - 2;
+			const PxU8 vref0 = polygons[data.mIndexBase + 0];
+			for (PxU32 j = 0; j < nbTris; j++)
+			{
+				const PxU32 vref1 = polygons[data.mIndexBase + 0 + j + 1];
+				const PxU32 vref2 = polygons[data.mIndexBase + 0 + j + 2];
+				if (numTotalTriangles < MAX_NUM_CONVEXMESH_TRIANGLES)
+				{
+					gConvexMeshTriIndices[3 * numTotalTriangles + 0] = vref0;
+					gConvexMeshTriIndices[3 * numTotalTriangles + 1] = vref1;
+					gConvexMeshTriIndices[3 * numTotalTriangles + 2] = vref2;
+					numTotalTriangles++;
+				}
+			}
+		}
 
-		t[0][0][0] = t[4][0][0] = t[0][1][0] = t[2][1][0] = t[0][2][0] = t[1][2][0] = 1.f;
-		t[0][0][1] = t[4][0][1] = t[0][1][1] = t[2][1][1] = t[0][2][1] = t[1][2][1] = 1.f;
+		if (numTotalTriangles < MAX_NUM_CONVEXMESH_TRIANGLES)
+		{
+			glEnableClientState(GL_VERTEX_ARRAY);
+			glVertexPointer(3, GL_FLOAT, 0, verts);
+			glDrawElements(GL_TRIANGLES, numTotalTriangles * 3, GL_UNSIGNED_INT, gConvexMeshTriIndices);
+			glDisableClientState(GL_VERTEX_ARRAY);
+		}
+	}
 
-		t[1][0][0] = t[5][0][0] = t[1][1][0] = t[3][1][0] = t[3][2][0] = t[2][2][0] = 1.f;
-		t[1][0][1] = t[5][0][1] = t[1][1][1] = t[3][1][1] = t[3][2][1] = t[2][2][1] = 1.f;
+	void GLUTGame::SetSimplifiedHull(const PxConvexMesh* mesh, PxConvexMesh* simplified)
+	{
+		if (simplified)
+			m_simplifiedHulls[mesh] = simplified;
+		else
+			m_simplifiedHulls.erase(mesh);
+	}
 
-		t[2][0][0] = t[6][0][0] = t[4][1][0] = t[6][1][0] = t[4][2][0] = t[5][2][0] = 1.f;
-		t[2][0][1] = t[6][0][1] = t[4][1][1] = t[6][1][1] = t[4][2][1] = t[5][2][1] = 1.f;
+	// Unit cube drawn from the prebuilt vertex table, scale by the shape's half extents before calling
+	void GLUTGame::RenderCube(bool textured)
+	{
+		if (textured)
+			glInterleavedArrays(GL_T2F_N3F_V3F, 0, gUnitCube);
+		else
+			glInterleavedArrays(GL_N3F_V3F, sizeof(CubeVertex), &gUnitCube[0].nx);
 
-		t[3][0][0] = t[7][0][0] = t[5][1][0] = t[7][1][0] = t[7][2][0] = t[6][2][0] = 1.f;
-		t[3][0][1] = t[7][0][1] = t[5][1][1] = t[7][1][1] = t[7][2][1] = t[6][2][1] = 1.f;
+		glDrawArrays(GL_QUADS, 0, CUBE_VERTS);
 
-		for (i = 5; i >= 0; i--) {
-			glBegin(GL_QUADS);
-			glNormal3fv(&n[i][0]);
-			glTexCoord2f(t[i][i][0], t[i][i][1]);
-			glVertex3fv(&v[faces[i][0]][0]);
-			glVertex3fv(&v[faces[i][1]][0]);
-			glVertex3fv(&v[faces[i][2]][0]);
-			glVertex3fv(&v[faces[i][3]][0]);
-			glEnd();
-		}
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_NORMAL_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
 	}
 
 	void GLUTGame::SetClearColor(const Vec3& color)
 	{
-		ClearColor = color;
-		glClearColor(color.x, color.y, color.z, 1.f);
+		ClearColor = color; // Applied by ClearFrame, from the snapshot
 	}
 
 	Vec3 GLUTGame::GetClearColor()
@@ -257,19 +636,332 @@ namespace GameFramework
 
 		if (m_time - m_timebase > 1000)
 		{
-			m_fps = m_frame*1000.0 / (m_time - m_timebase);
+			m_fps = (int)(m_frame*1000.0 / (m_time - m_timebase));
 			m_timebase = m_time;
 			m_frame = 0;
 		}
 	}
 
+	void GLUTGame::PresentFrame()
+	{
+		UpdateCapture();
+
+		// Free textures whose last handle was dropped (possibly on the simulation thread), and upload newly decoded ones
+		TextureManager::Update();
+
+		if (m_showProfileGraph)
+		{
+			ProfileScope scope(m_profiler, ProfilePhase::HUD);
+			Fl32 rate = TargetFrameRate() > 0 ? TargetFrameRate() : FPS;
+			m_profiler.RenderGraph(1000.f / rate);
+		}
+
+		{
+			ProfileScope scope(m_profiler, ProfilePhase::Swap);
+			if (m_offscreen)
+				glFinish();
+			else
+				glutSwapBuffers();
+		}
+
+		if (m_startupComplete && StartupTrace::FirstFrame() < 0)
+			StartupTrace::MarkFirstFrame();
+
+		m_profiler.EndFrame();
+	}
+
+	void GLUTGame::MarkStartupComplete()
+	{
+		m_startupComplete = true;
+	}
+
+	void GLUTGame::ReportProfile()
+	{
+		std::string report = m_profiler.Report();
+		if (m_threaded)
+			report = "Render thread - " + report + "Simulation thread - " + m_simulationProfiler.Report();
+
+		Log::Write(report.c_str(), PROFILE_LOG);
+		Log::Write(report.c_str(), ENGINE_LOG);
+	}
+
+	void GLUTGame::ToggleProfileGraph()
+	{
+		m_showProfileGraph = !m_showProfileGraph;
+	}
+
+	void GLUTGame::PostRedisplay()
+	{
+		// The GLUT thread redraws every frame in threaded mode, and GLUT must not be called from elsewhere
+		if (!m_offscreen && !OnSimulationThread())
+			glutPostRedisplay();
+	}
+
+	void GLUTGame::SetThreadedSimulation(bool enabled)
+	{
+		if (m_simulationRunning)
+		{
+			Log::Write("Exc: Threaded simulation can't be changed while running!\n", ENGINE_LOG);
+			return;
+		}
+		m_threaded = enabled;
+	}
+
+	void GLUTGame::SetSimulationRate(Fl32 ticksPerSecond)
+	{
+		m_simulationPacer.SetTargetRate(ticksPerSecond);
+	}
+
+	bool GLUTGame::OnSimulationThread() const
+	{
+		return m_threaded && std::this_thread::get_id() == m_simulationThread.get_id();
+	}
+
+	FrameProfiler& GLUTGame::SimulationProfiler()
+	{
+		return m_threaded ? m_simulationProfiler : m_profiler;
+	}
+
+	void GLUTGame::SimulationLoop()
+	{
+		while (m_simulationRunning)
+		{
+			m_simulationPacer.Wait();
+			DrainInput();
+			Tick();
+			m_simulationProfiler.EndFrame();
+		}
+	}
+
+	void GLUTGame::Tick()
+	{
+		CalculateDeltaTime();
+
+		{
+			ProfileScope scope(SimulationProfiler(), ProfilePhase::Logic);
+			Idle();
+		}
+
+		{
+			ProfileScope scope(SimulationProfiler(), ProfilePhase::Physics);
+			Simulate();
+		}
+
+		PublishSnapshot();
+	}
+
+	void GLUTGame::PublishSnapshot()
+	{
+		CaptureSnapshot(m_snapshots.Back());
+		m_snapshots.Publish();
+	}
+
+	void GLUTGame::HandleInput(const InputEvent& e)
+	{
+		if (m_threaded)
+		{
+			std::lock_guard<std::mutex> lock(m_inputMutex);
+			m_inputQueue.push_back(e);
+		}
+		else
+			DispatchInput(e);
+	}
+
+	void GLUTGame::DrainInput()
+	{
+		{
+			// Swap rather than copy, so the GLUT thread holds the lock only for a push
+			std::lock_guard<std::mutex> lock(m_inputMutex);
+			m_inputDrain.swap(m_inputQueue);
+		}
+
+		for (std::vector<InputEvent>::iterator iter = m_inputDrain.begin(); iter != m_inputDrain.end(); iter++)
+			DispatchInput(*iter);
+		m_inputDrain.clear();
+	}
+
+	void GLUTGame::DispatchInput(const InputEvent& e)
+	{
+		ProfileScope scope(SimulationProfiler(), ProfilePhase::Input);
+
+		switch (e.type)
+		{
+		case InputType::MouseButton:
+			MouseButton(e.key, e.state, e.x, e.y);
+			break;
+		case InputType::MouseMove:
+			MouseMove(e.x, e.y);
+			break;
+		case InputType::KeyboardDown:
+			KeyboardDown((unsigned char)e.key, e.x, e.y);
+			break;
+		case InputType::KeyboardUp:
+			KeyboardUp((unsigned char)e.key, e.x, e.y);
+			break;
+		case InputType::SpecKeyboardDown:
+			SpecKeyboardDown(e.key, e.x, e.y);
+			break;
+		case InputType::SpecKeyboardUp:
+			SpecKeyboardUp(e.key, e.x, e.y);
+			break;
+		}
+	}
+
+	void GLUTGame::RequestExit(int status)
+	{
+		m_exitStatus = status;
+		if (OnSimulationThread())
+			m_exitRequested = true;
+		else
+			exit(status);
+	}
+
+	void GLUTGame::Simulate()
+	{
+		StepPhysics();
+	}
+
+	void GLUTGame::CaptureSnapshot(FrameSnapshot& snapshot)
+	{
+		snapshot.clearColor = ClearColor;
+		snapshot.shapes.clear(); // Keeps capacity, so capturing does not allocate
+
+		// Paused, the current poses hold
+		snapshot.captured = FrameClockType::now();
+		snapshot.owed = simTimer;
+		snapshot.stepTime = m_scene->IsPaused() ? 0.f : m_pxTimeStep;
+	}
+
+	const FrameSnapshot& GLUTGame::Snapshot() const
+	{
+		return m_snapshots.Front();
+	}
+
+	void GLUTGame::ClearFrame()
+	{
+		const Vec3& color = Snapshot().clearColor;
+		glClearColor(color.x, color.y, color.z, 1.f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	}
+
+	void GLUTGame::RenderShapes(const FrameSnapshot& snapshot)
+	{
+		// Interpolated shapes are blended here, so each frame drawn from a snapshot is placed at its own time
+		Fl32 alpha = snapshot.Alpha(FrameClockType::now());
+
+		if (m_renderBackend == RenderBackend::Core)
+		{
+			m_coreRenderer.Render(snapshot, alpha, camera.GetViewMatrix(), camera.GetProjectionMatrix(AspectRatio()), m_simplifiedHulls);
+			return;
+		}
+
+		// Pixels covered by one unit at a distance of one unit along the view axis, from the camera the fixed function
+		// matrices were loaded from, rather than reading them back for every shape
+		const Mat44 view = camera.GetViewMatrix();
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		const Fl32 pixelScale = camera.GetProjectionMatrix(AspectRatio()).column1.y * viewport[3] * .5f;
+
+		for (std::vector<ShapeDraw>::const_iterator iter = snapshot.shapes.begin(); iter != snapshot.shapes.end(); iter++)
+		{
+			Mat44 pose = iter->PoseAt(alpha);
+
+			// At or behind the eye, draw full detail
+			Fl32 depth = -view.transform(pose.getPosition()).z;
+			Fl32 pixelsPerUnit = depth > 0.f ? pixelScale / depth : FLT_MAX;
+
+			glPushMatrix();
+			glMultMatrixf((Fl32*)&pose); // Multiply current matrix by pose
+
+			glColor3f(iter->color.x, iter->color.y, iter->color.z);
+
+			bool plane = iter->geometry.getType() == PxGeometryType::ePLANE;
+			if (plane)
+				glDisable(GL_LIGHTING);
+
+			RenderGeometry(iter->geometry, pixelsPerUnit, iter->textured);
+
+			if (plane)
+				glEnable(GL_LIGHTING);
+
+			glPopMatrix();
+		}
+
+		Vec3 defCol = DEFAULT_COLOR;
+		glColor3f(defCol.x, defCol.y, defCol.z);
+	}
+
 	void GLUTGame::CalculateDeltaTime()
 	{
-		newElapsedTime = clock();
-		deltaTime = newElapsedTime - lastElapsedTime;
-		deltaTime = deltaTime / (double)CLOCKS_PER_SEC;
-		deltaTime = deltaTime / 1000;
-		lastElapsedTime = newElapsedTime;
+		deltaTime = (Fl32)m_frameClock.Tick();
+	}
+
+	void GLUTGame::SetTargetFrameRate(Fl32 framesPerSecond)
+	{
+		m_framePacer.SetTargetRate(framesPerSecond);
+	}
+
+	Fl32 GLUTGame::TargetFrameRate() const
+	{
+		return (Fl32)m_framePacer.TargetRate();
+	}
+
+	void GLUTGame::SetCapture(bool enabled, CaptureFormat format)
+	{
+		m_captureFormat = (int)format;
+		m_captureWanted = enabled;
+	}
+
+	bool GLUTGame::IsCapturing() const
+	{
+		return m_captureWanted;
+	}
+
+	void GLUTGame::UpdateCapture()
+	{
+		if (m_captureWanted && !m_capture.IsCapturing())
+		{
+			time_t now = time(NULL);
+			tm local;
+			localtime_s(&local, &now);
+			char directory[64];
+			strftime(directory, sizeof(directory), "capture_%Y%m%d_%H%M%S", &local);
+
+			GLint viewport[4];
+			glGetIntegerv(GL_VIEWPORT, viewport);
+			if (!m_capture.Start(directory, (CaptureFormat)m_captureFormat.load(), viewport[2], viewport[3], m_offscreen))
+				m_captureWanted = false;
+		}
+		else if (!m_captureWanted && m_capture.IsCapturing())
+			m_capture.Stop();
+
+		m_capture.Capture();
+	}
+
+	void GLUTGame::SetVSync(bool enabled)
+	{
+		m_vsync = enabled;
+
+		// No window yet (or none at all), applied in Run
+		if (m_offscreen || wglGetCurrentContext() == NULL)
+			return;
+
+		typedef BOOL (WINAPI *SwapIntervalEXTProc)(int);
+		SwapIntervalEXTProc swapInterval = (SwapIntervalEXTProc)wglGetProcAddress("wglSwapIntervalEXT");
+		if (!swapInterval || !swapInterval(enabled ? 1 : 0))
+		{
+			if (enabled)
+				Log::Write("VSync unavailable, WGL_EXT_swap_control is not supported!\n", ENGINE_LOG);
+			m_framePacer.SetVSync(false, 0);
+			return;
+		}
+
+		HDC screen = GetDC(NULL);
+		int refreshRate = GetDeviceCaps(screen, VREFRESH);
+		ReleaseDC(NULL, screen);
+
+		// 0 and 1 mean the hardware default refresh rate, so the pacer can't rely on the swap
+		m_framePacer.SetVSync(enabled, refreshRate > 1 ? refreshRate : 0);
 	}
 
 	/*-------------------------------------------------------------------------\
@@ -283,14 +975,7 @@ namespace GameFramework
 
 	void GLUTGame::Idle()
 	{
-		CalculateDeltaTime();
 
-		m_milliSecondsSinceLastFrame += deltaTime;
-		if (m_milliSecondsSinceLastFrame * 1000 >= 1.f / 60.f)
-		{
-			glutPostRedisplay();
-			m_milliSecondsSinceLastFrame = 0.f;
-		}
 	}
 
 	void GLUTGame::Reshape(int width, int height)
@@ -334,8 +1019,25 @@ namespace GameFramework
 
 	void GLUTGame::Exit()
 	{
+		if (m_simulationThread.joinable())
+		{
+			m_simulationRunning = false;
+			if (OnSimulationThread())
+				m_simulationThread.detach();
+			else
+				m_simulationThread.join();
+		}
+
+		if (!m_offscreen)
+			timeEndPeriod(1);
+
+		m_capture.Stop();
+		TextureManager::Shutdown();
+		StartupTrace::Write(); // If the first frame never came
+		ReportProfile();
+		Audio::Shutdown(); // Before the log closes, as loads still queued may report errors
 		Log::Shutdown();
-		BASS_Free();
+		AssetArchive::Close(); // After the decoding and audio threads have stopped reading from it
 	}
 
 	Vec2 GLUTGame::WindowDimensions() const
@@ -347,19 +1049,34 @@ namespace GameFramework
 	| WRAPPER FUNCTION DEFINITIONS - USED TO CALL INSTANCE EQUIVALENT FUNCTIONS |
 	\-------------------------------------------------------------------------*/
 
-	void GLUTGame::RenderWrapper() { instance->Render(); }
-	void GLUTGame::IdleWrapper() { instance->Idle(); }
+	void GLUTGame::RenderWrapper()
+	{
+		instance->m_snapshots.Acquire(); // Draw the newest snapshot, or the last one again if none is new
+		instance->Render();
+	}
+	void GLUTGame::IdleWrapper()
+	{
+		// Sleep out the rest of the frame, rather than spinning through idle callbacks
+		instance->m_framePacer.Wait();
+
+		if (!instance->m_threaded)
+			instance->Tick();
+		else if (instance->m_exitRequested)
+			exit(instance->m_exitStatus);
+
+		instance->PostRedisplay();
+	}
 	void GLUTGame::ReshapeWrapper(int width, int height) { instance->Reshape(width, height); }
 
 	// Mouse Wrappers
-	void GLUTGame::MouseButtonWrapper(int button, int state, int x, int y) { instance->MouseButton(button, state, x, y); }
-	void GLUTGame::MouseMoveWrapper(int x, int y) { instance->MouseMove(x, y); }
+	void GLUTGame::MouseButtonWrapper(int button, int state, int x, int y) { InputEvent e = { InputType::MouseButton, button, state, x, y }; instance->HandleInput(e); }
+	void GLUTGame::MouseMoveWrapper(int x, int y) { InputEvent e = { InputType::MouseMove, 0, 0, x, y }; instance->HandleInput(e); }
 
 	// Keyboard Wrappers
-	void GLUTGame::KeyboardDownWrapper(unsigned char key, int x, int y) { instance->KeyboardDown(key, x, y); }
-	void GLUTGame::KeyboardUpWrapper(unsigned char key, int x, int y) { instance->KeyboardUp(key, x, y); }
-	void GLUTGame::SpecKeyboardDownWrapper(int key, int x, int y) { instance->SpecKeyboardDown(key, x, y); }
-	void GLUTGame::SpecKeyboardUpWrapper(int key, int x, int y) { instance->SpecKeyboardUp(key, x, y); }
+	void GLUTGame::KeyboardDownWrapper(unsigned char key, int x, int y) { InputEvent e = { InputType::KeyboardDown, key, 0, x, y }; instance->HandleInput(e); }
+	void GLUTGame::KeyboardUpWrapper(unsigned char key, int x, int y) { InputEvent e = { InputType::KeyboardUp, key, 0, x, y }; instance->HandleInput(e); }
+	void GLUTGame::SpecKeyboardDownWrapper(int key, int x, int y) { InputEvent e = { InputType::SpecKeyboardDown, key, 0, x, y }; instance->HandleInput(e); }
+	void GLUTGame::SpecKeyboardUpWrapper(int key, int x, int y) { InputEvent e = { InputType::SpecKeyboardUp, key, 0, x, y }; instance->HandleInput(e); }
 
 	// Exit Wrapper
 	void GLUTGame::ExitWrapper() { instance->Exit(); }
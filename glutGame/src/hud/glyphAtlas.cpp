@@ -0,0 +1,120 @@
+/*-------------------------------------------------------------------------\
+| File: GLYPHATLAS.CPP														|
+| Desc: Provides definitions for a texture atlas of GLUT bitmap glyphs		|
+| Declaration File: GLYPHATLAS.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "glyphAtlas.h"
+
+namespace GameFramework
+{
+	static const int ATLAS_WIDTH = GLYPH_COLUMNS * GLYPH_CELL;
+	static const int ATLAS_HEIGHT = GLYPH_ROWS * GLYPH_CELL;
+
+	GlyphAtlas::GlyphAtlas()
+	{
+		m_texID = 0;
+		m_font = nullptr;
+		m_descent = 0;
+		for (int i = 0; i < GLYPH_COUNT; i++)
+			m_advance[i] = 0;
+	}
+
+	GlyphAtlas::~GlyphAtlas()
+	{
+
+	}
+
+	void GlyphAtlas::Build(void* font, int descent)
+	{
+		m_font = font;
+		m_descent = descent;
+
+		glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+		glDisable(GL_LIGHTING);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_TEXTURE_2D);
+
+		// Pixel aligned projection, so each glyph lands exactly in its cell
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		glMatrixMode(GL_PROJECTION);
+			glPushMatrix();
+			glLoadIdentity();
+			gluOrtho2D(0.0, viewport[2], 0.0, viewport[3]);
+		glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+
+		glClearColor(0.f, 0.f, 0.f, 0.f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glColor3f(1.f, 1.f, 1.f);
+
+		for (int i = 0; i < GLYPH_COUNT; i++)
+		{
+			int col = i % GLYPH_COLUMNS;
+			int row = i / GLYPH_COLUMNS;
+			glRasterPos2i(col * GLYPH_CELL + GLYPH_PADDING, row * GLYPH_CELL + m_descent);
+			glutBitmapCharacter(m_font, GLYPH_FIRST + i);
+			m_advance[i] = glutBitmapWidth(m_font, GLYPH_FIRST + i);
+		}
+
+		// Copy the glyph grid into an intensity texture, so the HUD color modulates it
+		glGenTextures(1, &m_texID);
+		glBindTexture(GL_TEXTURE_2D, m_texID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glCopyTexImage2D(GL_TEXTURE_2D, 0, GL_INTENSITY, 0, 0, ATLAS_WIDTH, ATLAS_HEIGHT, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		glMatrixMode(GL_PROJECTION);
+			glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+			glPopMatrix();
+		glPopAttrib();
+	}
+
+	Fl32 GlyphAtlas::Append(std::vector<GlyphVertex>& run, const char* text, int length, Fl32 penX, Fl32 penY) const
+	{
+		const Fl32 cellS = (Fl32)GLYPH_CELL / ATLAS_WIDTH;
+		const Fl32 cellT = (Fl32)GLYPH_CELL / ATLAS_HEIGHT;
+
+		for (int i = 0; i < length; i++)
+		{
+			int c = (unsigned char)text[i];
+			if (c < GLYPH_FIRST || c > GLYPH_LAST)
+				continue;
+
+			int idx = c - GLYPH_FIRST;
+
+			// Spaces only move the pen
+			if (c != ' ')
+			{
+				Fl32 s0 = (idx % GLYPH_COLUMNS) * cellS;
+				Fl32 t0 = (idx / GLYPH_COLUMNS) * cellT;
+				Fl32 x0 = penX - GLYPH_PADDING;
+				Fl32 y0 = penY - m_descent;
+
+				GlyphVertex quad[4] =
+				{
+					{ s0,		  t0,		  x0,			   y0,				0.f },
+					{ s0 + cellS, t0,		  x0 + GLYPH_CELL, y0,				0.f },
+					{ s0 + cellS, t0 + cellT, x0 + GLYPH_CELL, y0 + GLYPH_CELL, 0.f },
+					{ s0,		  t0 + cellT, x0,			   y0 + GLYPH_CELL, 0.f }
+				};
+				run.insert(run.end(), quad, quad + 4);
+			}
+
+			penX += m_advance[idx];
+		}
+
+		return penX;
+	}
+
+	unsigned int GlyphAtlas::TextureID() const
+	{
+		return m_texID;
+	}
+}
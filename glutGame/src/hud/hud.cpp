@@ -1,13 +1,41 @@
 #include "hud.h"
+#include "glutGame.h"
 
 namespace GameFramework
 {
+	// Descent below the baseline of each GLUT bitmap font, in pixels
+	static const int LARGE_FONT_DESCENT = 7;
+	static const int SMALL_FONT_DESCENT = 5;
+
+	// Writes the decimal digits of value into buffer (12 chars or more), returns the number of characters written
+	static int FormatInt(int value, char* buffer)
+	{
+		char digits[12];
+		int n = 0;
+		unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+		do
+		{
+			digits[n++] = '0' + (u % 10);
+			u /= 10;
+		} while (u != 0);
+
+		int len = 0;
+		if (value < 0)
+			buffer[len++] = '-';
+		while (n > 0)
+			buffer[len++] = digits[--n];
+
+		return len;
+	}
+
 	HUDItem::HUDItem()
 	{
 		m_text = nullptr;
 		m_data = 0;
 		m_pos = Vec2(0, 0);
 		m_font = HUDFont::smallFont;
+		m_dirty = true;
 	}
 
 	HUDItem::HUDItem(std::string text, Vec2 pos, HUDFont font, bool dataItem, int data )
@@ -17,6 +45,7 @@ namespace GameFramework
 		m_pos = pos;
 		m_font = font;
 		m_dataItem = dataItem;
+		m_dirty = true;
 	}
 
 	HUDItem::~HUDItem()
@@ -27,6 +56,10 @@ namespace GameFramework
 	HUD::HUD()
 	{
 		m_items = std::vector<HUDItem>();
+		m_width = 0;
+		m_height = 0;
+		m_generation = 0;
+		m_layout = 1;
 	}
 
 	HUD::~HUD()
@@ -34,36 +67,90 @@ namespace GameFramework
 		m_items.clear();
 	}
 
+	void HUD::Init(int width, int height)
+	{
+		m_largeAtlas.Build((void*)HUDFont::largeFont, LARGE_FONT_DESCENT);
+		m_smallAtlas.Build((void*)HUDFont::smallFont, SMALL_FONT_DESCENT);
+		Resize(width, height);
+	}
+
+	void HUD::Resize(int width, int height)
+	{
+		if (width == m_width && height == m_height)
+			return;
+
+		m_width = width;
+		m_height = height;
+		for (std::vector<HUDItem>::iterator iter = m_items.begin(); iter < m_items.end(); iter++)
+			iter->m_dirty = true;
+	}
+
+	const GlyphAtlas& HUD::Atlas(HUDFont font) const
+	{
+		if (font == HUDFont::largeFont)
+			return m_largeAtlas;
+		else
+			return m_smallAtlas;
+	}
+
+	void HUD::BuildRun(HUDItem& item)
+	{
+		const GlyphAtlas& atlas = Atlas(item.m_font);
+
+		// Calculate Screen Position
+		Fl32 penX = (m_width / 100.f) * item.m_pos.x;
+		Fl32 penY = (m_height / 100.f) * item.m_pos.y;
+
+		item.m_run.clear(); // Keeps capacity, so rebuilding does not allocate
+		penX = atlas.Append(item.m_run, item.m_text.c_str(), item.m_text.length(), penX, penY);
+		if (item.m_dataItem)
+		{
+			char digits[12];
+			int nDigits = FormatInt(item.m_data, digits);
+			penX = atlas.Append(item.m_run, " : ", 3, penX, penY);
+			atlas.Append(item.m_run, digits, nDigits, penX, penY);
+		}
+
+		item.m_dirty = false;
+	}
+
 	void HUD::Render(Fl32 FOV)
 	{
+		glPushAttrib(GL_CURRENT_BIT);
 		glDisable(GL_LIGHTING);
 		glDisable(GL_DEPTH_TEST);
 		glMatrixMode(GL_PROJECTION);
 			glLoadIdentity();
-			gluOrtho2D(0.0, glutGet(GLUT_WINDOW_WIDTH), 0.0, glutGet(GLUT_WINDOW_HEIGHT));
+			gluOrtho2D(0.0, m_width, 0.0, m_height);
 		glMatrixMode(GL_MODELVIEW);
 			glPushMatrix();
 			glLoadIdentity();
 			glColor3f(textColor.x, textColor.y, textColor.z);
+
+			glEnable(GL_TEXTURE_2D);
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
 			for (std::vector<HUDItem>::iterator iter = m_items.begin(); iter < m_items.end(); iter++)
 			{
-				// Calculate Screen Position
-				Vec2 actualPos = Vec2((glutGet(GLUT_WINDOW_WIDTH) / 100) * iter->m_pos.x, (glutGet(GLUT_WINDOW_HEIGHT) / 100) * iter->m_pos.y);
-				glRasterPos2f(actualPos.x, actualPos.y);
-				for (int i = 0; i < iter->m_text.length(); i++)
-					glutBitmapCharacter((void*)iter->m_font, iter->m_text[i]);
-				if (iter->m_dataItem)
+				if (iter->m_dirty)
+					BuildRun(*iter);
+
+				if (iter->m_run.size())
 				{
-					glutBitmapCharacter((void*)iter->m_font, ' ');
-					glutBitmapCharacter((void*)iter->m_font, ':');
-					glutBitmapCharacter((void*)iter->m_font, ' ');
-					std::string s = std::to_string(iter->m_data);
-					for (int j = 0; j < s.length(); j++)
-						glutBitmapCharacter((void*)iter->m_font, s[j]);
+					glBindTexture(GL_TEXTURE_2D, Atlas(iter->m_font).TextureID());
+					glInterleavedArrays(GL_T2F_V3F, 0, &iter->m_run[0]);
+					glDrawArrays(GL_QUADS, 0, iter->m_run.size());
 				}
 			}
-			Vec3 clearCol = GLUTGame::GetClearColor();
-			glColor3f(clearCol.x, clearCol.y, clearCol.z);
+
+			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+			glDisableClientState(GL_VERTEX_ARRAY);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			glDisable(GL_BLEND);
+			glDisable(GL_TEXTURE_2D);
+
 			glPopMatrix();
 		glMatrixMode(GL_PROJECTION);
 			glLoadIdentity();
@@ -72,9 +159,10 @@ namespace GameFramework
 			glPopMatrix();
 		glEnable(GL_DEPTH_TEST);
 		glEnable(GL_LIGHTING);
+		glPopAttrib();
 	}
 
-	void HUD::AddItem(std::string text, Vec2 pos, HUDFont font, bool dataItem, int initialData)
+	HUDHandle HUD::AddItem(std::string text, Vec2 pos, HUDFont font, bool dataItem, int initialData)
 	{
 		if (pos.x > 100 || pos.y > 100 || pos.x < 0 || pos.y < 0)
 		{
@@ -84,28 +172,74 @@ namespace GameFramework
 		}
 
 		m_items.push_back(HUDItem(text, pos, font, dataItem, initialData));
+		m_layout++;
+		return HUDHandle(m_items.size() - 1, m_generation);
 	}
 
-	bool HUD::UpdateItem(std::string text, int newData)
+	bool HUD::UpdateItem(const HUDHandle& item, int newData)
 	{
-		for (std::vector<HUDItem>::iterator iter = m_items.begin(); iter < m_items.end(); iter++)
+		if (item.generation != m_generation || item.index < 0 || item.index >= (int)m_items.size())
+			return false;
+
+		HUDItem& target = m_items[item.index];
+		if (target.m_data != newData)
 		{
-			if (iter->m_text == text)
-			{
-				iter->m_data = newData;
-				return true;
-			}
+			target.m_data = newData;
+			target.m_dirty = true;
 		}
-		return false;
+		return true;
 	}
 
 	void HUD::SetRenderColor(Vec3 color)
 	{
 		textColor = color;
+		m_layout++;
 	}
 
 	void HUD::Clear()
 	{
 		m_items.clear();
+		m_generation++;
+		m_layout++;
+	}
+
+	void HUD::Capture(HUDSnapshot& snapshot) const
+	{
+		if (snapshot.layout != m_layout)
+		{
+			snapshot.items = m_items;
+			snapshot.color = textColor;
+			snapshot.layout = m_layout;
+		}
+		else
+		{
+			for (size_t i = 0; i < m_items.size(); i++)
+				snapshot.items[i].m_data = m_items[i].m_data;
+		}
+	}
+
+	void HUD::Apply(const HUDSnapshot& snapshot)
+	{
+		if (snapshot.layout != m_layout)
+		{
+			m_items = snapshot.items;
+			textColor = snapshot.color;
+			m_layout = snapshot.layout;
+			m_generation++;
+
+			for (std::vector<HUDItem>::iterator iter = m_items.begin(); iter < m_items.end(); iter++)
+				iter->m_dirty = true;
+		}
+		else
+		{
+			for (size_t i = 0; i < m_items.size(); i++)
+			{
+				if (m_items[i].m_data != snapshot.items[i].m_data)
+				{
+					m_items[i].m_data = snapshot.items[i].m_data;
+					m_items[i].m_dirty = true;
+				}
+			}
+		}
 	}
 }
\ No newline at end of file
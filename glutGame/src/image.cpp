@@ -1,18 +1,17 @@
 #include "image.h"
-#include "loadImage.h"
+#include <iostream>
 
 namespace GameFramework
 {
-	Image::Image(const std::string& fileName)
+	Image::Image(const std::string& fileName, bool background)
 	{
 		m_fileName = fileName;
-		m_texID = LoadTexture(m_fileName);
+		m_texture = background ? TextureManager::AcquireAsync(m_fileName) : TextureManager::Acquire(m_fileName);
 	}
 
 	Image::Image()
 	{
 		m_fileName = "";
-		m_texID = 0;
 	}
 
 	Image::Image(const Image& param)
@@ -33,8 +32,9 @@ namespace GameFramework
 
 	void Image::cpy(const Image& param)
 	{
+		// Copies share the texture
 		m_fileName = param.m_fileName;
-		m_texID = LoadTexture(m_fileName);
+		m_texture = param.m_texture;
 	}
 
 	Image::~Image()
@@ -42,8 +42,31 @@ namespace GameFramework
 
 	}
 
+	bool Image::IsLoaded() const
+	{
+		return m_texture && m_texture->IsLoaded();
+	}
+
+	bool Image::IsAcquired() const
+	{
+		return m_texture != nullptr;
+	}
+
+	unsigned int Image::Bytes() const
+	{
+		return m_texture ? m_texture->Bytes() : 0;
+	}
+
+	void Image::Release()
+	{
+		m_texture.reset();
+	}
+
 	void Image::Render()
 	{
+		if (!IsLoaded())
+			return;
+
 		glMatrixMode(GL_PROJECTION);
 		glLoadIdentity();
 		gluOrtho2D(0, 1, 1, 0);
@@ -56,7 +79,7 @@ namespace GameFramework
 
 		glGetError(); // Clear previous errors
 
-		glBindTexture(GL_TEXTURE_2D, m_texID);
+		glBindTexture(GL_TEXTURE_2D, m_texture ? m_texture->ID() : 0);
 
 		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_DECAL);
 
@@ -0,0 +1,121 @@
+/*-------------------------------------------------------------------------\
+| File: IMAGEDECODER.CPP													|
+| Desc: Provides definitions for a pool of worker threads decoding			|
+|		images into CPU side pixel buffers, ready for upload on the GL		|
+|		thread.																|
+| Declaration File: IMAGEDECODER.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "imageDecoder.h"
+#include "loadImage.h"
+#include "startupTrace.h"
+
+namespace GameFramework
+{
+	void DecodedImage::Free()
+	{
+		if (pixels != NULL)
+			SOIL_free_image_data(pixels);
+		pixels = NULL;
+	}
+
+	ImageDecoder::ImageDecoder()
+	{
+		m_stopping = false;
+	}
+
+	ImageDecoder::~ImageDecoder()
+	{
+		Stop();
+	}
+
+	void ImageDecoder::Start(unsigned int threads)
+	{
+		if (IsRunning())
+			return;
+
+		if (threads == 0)
+		{
+			unsigned int cores = std::thread::hardware_concurrency();
+			threads = cores > 1 ? cores - 1 : 1;
+		}
+
+		m_stopping = false;
+		for (unsigned int i = 0; i < threads; i++)
+			m_workers.push_back(std::thread(&ImageDecoder::WorkerLoop, this));
+	}
+
+	void ImageDecoder::Stop()
+	{
+		if (!IsRunning())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+			m_jobs.clear();
+		}
+		m_jobQueued.notify_all();
+
+		for (size_t i = 0; i < m_workers.size(); i++)
+			m_workers[i].join();
+		m_workers.clear();
+
+		for (size_t i = 0; i < m_decoded.size(); i++)
+			m_decoded[i].Free();
+		m_decoded.clear();
+	}
+
+	bool ImageDecoder::IsRunning() const
+	{
+		return !m_workers.empty();
+	}
+
+	void ImageDecoder::Queue(const std::string& dataPath)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_jobs.push_back(dataPath);
+		}
+		m_jobQueued.notify_one();
+	}
+
+	bool ImageDecoder::Poll(DecodedImage& image)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_decoded.empty())
+			return false;
+
+		std::swap(image, m_decoded.front());
+		m_decoded.pop_front();
+		return true;
+	}
+
+	void ImageDecoder::WorkerLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;)
+		{
+			while (m_jobs.empty() && !m_stopping)
+				m_jobQueued.wait(lock);
+
+			if (m_stopping)
+				break;
+
+			DecodedImage image;
+			image.path = m_jobs.front();
+			m_jobs.pop_front();
+			lock.unlock();
+
+			// Neither touches GL state, so they can run on any thread
+			{
+				TraceScope scope("Decode " + image.path);
+				if (!TextureCache::Read(image.path, TEXTURE_FLAGS, image.cached))
+					image.pixels = DecodeImage(image.path, &image.width, &image.height, &image.channels);
+			}
+
+			lock.lock();
+			m_decoded.push_back(std::move(image));
+		}
+	}
+}
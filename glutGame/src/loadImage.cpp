@@ -2,39 +2,144 @@
 
 namespace GameFramework
 {
-	unsigned int LoadTexture(const std::string& dataPath)
+	// GL 1.3 tokens, not in the Windows SDK headers
+	static const GLenum TEXTURE_COMPRESSED_IMAGE_SIZE = 0x86A0;
+	static const GLenum TEXTURE_COMPRESSED = 0x86A1;
+
+	// Logs SOIL's reason for failing on an image
+	static void LogSOILError(const std::string& path)
 	{
-		glEnable(GL_TEXTURE_2D);
+		std::string s = "\n\n---- SOIL ERROR ----\nFilename: " + path;
+		s.append("\nSOIL Message: ");
+		s.append(SOIL_last_result());
+		s.append("\n\n");
+
+		Log::Write(s.c_str(), ENGINE_LOG);
+	}
 
+	// Applies the filtering every texture uses
+	static void SetTextureParameters(unsigned int tex_2d)
+	{
+		glBindTexture(GL_TEXTURE_2D, tex_2d);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	std::string ImagePath(const std::string& dataPath)
+	{
 		std::string fPath = GetCurrentDir(); // Get current directory, SOIL doesn't seem to work from executable directory
 
 		fPath.append("img\\" + dataPath);
+		return fPath;
+	}
 
-		unsigned int tex_2d = SOIL_load_OGL_texture
-			(
-			fPath.c_str(),
-			SOIL_LOAD_AUTO,
-			SOIL_CREATE_NEW_ID,
-			SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y | SOIL_FLAG_NTSC_SAFE_RGB | SOIL_FLAG_COMPRESS_TO_DXT
-			);
+	unsigned char* DecodeImage(const std::string& dataPath, int* width, int* height, int* channels)
+	{
+		AssetView view;
+		if (AssetArchive::Find("img", dataPath.c_str(), view))
+			return SOIL_load_image_from_memory(view.data, view.size, width, height, channels, SOIL_LOAD_AUTO);
+		return SOIL_load_image(ImagePath(dataPath).c_str(), width, height, channels, SOIL_LOAD_AUTO);
+	}
 
-		if (tex_2d == 0)
+	unsigned int LoadTexture(const std::string& dataPath)
+	{
+		CachedTexture cached;
+		if (TextureCache::Read(dataPath, TEXTURE_FLAGS, cached))
 		{
-			std::string s = "\n\n---- SOIL ERROR ----\nFilename: " + fPath;
-			s.append("\nSOIL Message: ");
-			s.append(SOIL_last_result());
-			s.append("\n\n");
+			unsigned int tex_2d = UploadTexture(cached);
+			if (tex_2d != 0)
+				return tex_2d;
+		}
+
+		glEnable(GL_TEXTURE_2D);
 
-			Log::Write(s.c_str(), ENGINE_LOG);
+		std::string fPath = ImagePath(dataPath);
+
+		// Read straight out of the mapped archive when it holds the image
+		unsigned int tex_2d;
+		AssetView view;
+		if (AssetArchive::Find("img", dataPath.c_str(), view))
+			tex_2d = SOIL_load_OGL_texture_from_memory(view.data, view.size, SOIL_LOAD_AUTO, SOIL_CREATE_NEW_ID, TEXTURE_FLAGS);
+		else
+		{
+			tex_2d = SOIL_load_OGL_texture
+				(
+				fPath.c_str(),
+				SOIL_LOAD_AUTO,
+				SOIL_CREATE_NEW_ID,
+				TEXTURE_FLAGS
+				);
 		}
 
-		glBindTexture(GL_TEXTURE_2D, tex_2d);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		if (tex_2d == 0)
+			LogSOILError(fPath);
+		else
+			TextureCache::Write(dataPath, TEXTURE_FLAGS, tex_2d);
+
+		SetTextureParameters(tex_2d);
 
 		glDisable(GL_TEXTURE_2D);
 
 		return tex_2d;
 	}
+
+	unsigned int UploadTexture(const unsigned char* pixels, int width, int height, int channels, const std::string& dataPath)
+	{
+		glEnable(GL_TEXTURE_2D);
+
+		unsigned int tex_2d = SOIL_create_OGL_texture(pixels, width, height, channels, SOIL_CREATE_NEW_ID, TEXTURE_FLAGS);
+
+		if (tex_2d == 0)
+			LogSOILError(ImagePath(dataPath));
+		else
+			TextureCache::Write(dataPath, TEXTURE_FLAGS, tex_2d);
+
+		SetTextureParameters(tex_2d);
+
+		glDisable(GL_TEXTURE_2D);
+
+		return tex_2d;
+	}
+
+	unsigned int UploadTexture(const CachedTexture& cached)
+	{
+		unsigned int tex_2d = TextureCache::Upload(cached);
+		if (tex_2d != 0)
+			SetTextureParameters(tex_2d);
+		return tex_2d;
+	}
+
+	unsigned int TextureMemory(unsigned int textureID)
+	{
+		if (textureID == 0)
+			return 0;
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		GLint compressed = 0;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, TEXTURE_COMPRESSED, &compressed);
+
+		unsigned int bytes = 0;
+		for (GLint level = 0;; level++)
+		{
+			GLint width = 0, height = 0, size = 0;
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+			if (width == 0 || height == 0)
+				break; // Past the end of the chain
+
+			if (compressed)
+				glGetTexLevelParameteriv(GL_TEXTURE_2D, level, TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+			else
+				size = width * height * 4;
+			bytes += size;
+
+			if (width == 1 && height == 1)
+				break;
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return bytes;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*-------------------------------------------------------------------------\
+| File: MESHLOD.CPP															|
+| Desc: Provides definitions for precomputed sphere meshes at several		|
+|		levels of detail, chosen by their size on screen.					|
+| Declaration File: MESHLOD.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "meshLOD.h"
+#include <cmath>
+
+namespace GameFramework
+{
+	// Tessellation of each level (slices, stacks), and the largest on screen radius in pixels it is used up to
+	static const int SPHERE_LOD_SLICES[SPHERE_LOD_COUNT] = { 8, 12, 16, 32 };
+	static const int SPHERE_LOD_STACKS[SPHERE_LOD_COUNT] = { 6, 10, 14, 24 };
+	static const Fl32 SPHERE_LOD_PIXELS[SPHERE_LOD_COUNT - 1] = { 6.f, 20.f, 60.f };
+
+	/*-------------------------------------------------------------------------\
+	|							SPHERE MESH DEFINITIONS							|
+	\-------------------------------------------------------------------------*/
+	SphereMesh::SphereMesh()
+	{
+
+	}
+
+	SphereMesh::~SphereMesh()
+	{
+
+	}
+
+	void SphereMesh::Build(int slices, int stacks)
+	{
+		m_vertices.clear();
+		m_indices.clear();
+
+		// Rings of slices + 1 vertices from pole to pole, the seam is duplicated so every quad indexes forward
+		for (int i = 0; i <= stacks; i++)
+		{
+			Fl32 phi = PI * i / stacks;
+			for (int j = 0; j <= slices; j++)
+			{
+				Fl32 theta = 2 * PI * j / slices;
+				GLfloat x = sinf(phi) * cosf(theta);
+				GLfloat y = sinf(phi) * sinf(theta);
+				GLfloat z = cosf(phi);
+
+				MeshVertex v = { x, y, z, x, y, z }; // Unit sphere, so the normal is the position
+				m_vertices.push_back(v);
+			}
+		}
+
+		for (int i = 0; i < stacks; i++)
+		{
+			for (int j = 0; j < slices; j++)
+			{
+				GLushort a = i * (slices + 1) + j;
+				GLushort b = a + slices + 1;
+
+				m_indices.push_back(a);
+				m_indices.push_back(b);
+				m_indices.push_back(a + 1);
+
+				m_indices.push_back(a + 1);
+				m_indices.push_back(b);
+				m_indices.push_back(b + 1);
+			}
+		}
+	}
+
+	void SphereMesh::Render() const
+	{
+		if (m_indices.empty())
+			return;
+
+		glInterleavedArrays(GL_N3F_V3F, 0, &m_vertices[0]);
+		glDrawElements(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_SHORT, &m_indices[0]);
+		glDisableClientState(GL_NORMAL_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+
+	int SphereMesh::TriangleCount() const
+	{
+		return m_indices.size() / 3;
+	}
+
+	const std::vector<MeshVertex>& SphereMesh::Vertices() const
+	{
+		return m_vertices;
+	}
+
+	const std::vector<GLushort>& SphereMesh::Indices() const
+	{
+		return m_indices;
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							SPHERE LOD SET DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	SphereLODSet::SphereLODSet()
+	{
+
+	}
+
+	SphereLODSet::~SphereLODSet()
+	{
+
+	}
+
+	void SphereLODSet::Build()
+	{
+		for (int i = 0; i < SPHERE_LOD_COUNT; i++)
+			m_lods[i].Build(SPHERE_LOD_SLICES[i], SPHERE_LOD_STACKS[i]);
+	}
+
+	const SphereMesh& SphereLODSet::Select(Fl32 pixelRadius) const
+	{
+		return m_lods[SelectIndex(pixelRadius)];
+	}
+
+	int SphereLODSet::SelectIndex(Fl32 pixelRadius) const
+	{
+		for (int i = 0; i < SPHERE_LOD_COUNT - 1; i++)
+		{
+			if (pixelRadius < SPHERE_LOD_PIXELS[i])
+				return i;
+		}
+		return SPHERE_LOD_COUNT - 1;
+	}
+
+	const SphereMesh& SphereLODSet::Level(int index) const
+	{
+		return m_lods[index];
+	}
+}
@@ -0,0 +1,211 @@
+/*-------------------------------------------------------------------------\
+| File: OFFSCREENCONTEXT.CPP												|
+| Desc: Provides definitions for a windowless OpenGL context, rendering		|
+|		into a pbuffer (works with Mesa's software rasterizer).				|
+| Declaration File: OFFSCREENCONTEXT.H										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "offscreenContext.h"
+#include "log.h"
+#include "GL/glut.h"
+
+// WGL_ARB_pixel_format / WGL_ARB_pbuffer tokens (not in the Windows SDK headers)
+#define WGL_DRAW_TO_PBUFFER_ARB		0x202D
+#define WGL_SUPPORT_OPENGL_ARB		0x2010
+#define WGL_DOUBLE_BUFFER_ARB		0x2011
+#define WGL_PIXEL_TYPE_ARB			0x2013
+#define WGL_COLOR_BITS_ARB			0x2014
+#define WGL_ALPHA_BITS_ARB			0x201B
+#define WGL_DEPTH_BITS_ARB			0x2022
+#define WGL_TYPE_RGBA_ARB			0x202B
+
+#define OFFSCREEN_WINDOW_CLASS "GLUTGameOffscreen"
+
+namespace GameFramework
+{
+	typedef BOOL (WINAPI *ChoosePixelFormatARBProc)(HDC, const int*, const FLOAT*, UINT, int*, UINT*);
+	typedef HPBUFFERARB (WINAPI *CreatePbufferARBProc)(HDC, int, int, int, const int*);
+	typedef HDC (WINAPI *GetPbufferDCARBProc)(HPBUFFERARB);
+	typedef int (WINAPI *ReleasePbufferDCARBProc)(HPBUFFERARB, HDC);
+	typedef BOOL (WINAPI *DestroyPbufferARBProc)(HPBUFFERARB);
+
+	OffscreenContext::OffscreenContext()
+	{
+		m_dummyWindow = NULL;
+		m_dummyDC = NULL;
+		m_dummyRC = NULL;
+		m_pbuffer = NULL;
+		m_pbufferDC = NULL;
+		m_pbufferRC = NULL;
+		m_releasePbufferDC = NULL;
+		m_destroyPbuffer = NULL;
+		m_width = 0;
+		m_height = 0;
+	}
+
+	OffscreenContext::~OffscreenContext()
+	{
+		Release();
+	}
+
+	bool OffscreenContext::CreateDummy()
+	{
+		WNDCLASS wc = { 0 };
+		wc.lpfnWndProc = DefWindowProc;
+		wc.hInstance = GetModuleHandle(NULL);
+		wc.lpszClassName = OFFSCREEN_WINDOW_CLASS;
+		RegisterClass(&wc);
+
+		// Never shown, only used to get a device context for the first GL context
+		m_dummyWindow = CreateWindow(OFFSCREEN_WINDOW_CLASS, "", WS_POPUP, 0, 0, 1, 1, NULL, NULL, wc.hInstance, NULL);
+		if (m_dummyWindow == NULL)
+			return false;
+
+		m_dummyDC = GetDC(m_dummyWindow);
+
+		PIXELFORMATDESCRIPTOR pfd = { 0 };
+		pfd.nSize = sizeof(pfd);
+		pfd.nVersion = 1;
+		pfd.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL;
+		pfd.iPixelType = PFD_TYPE_RGBA;
+		pfd.cColorBits = 32;
+
+		int format = ChoosePixelFormat(m_dummyDC, &pfd);
+		if (format == 0 || !SetPixelFormat(m_dummyDC, format, &pfd))
+			return false;
+
+		m_dummyRC = wglCreateContext(m_dummyDC);
+		return m_dummyRC != NULL && wglMakeCurrent(m_dummyDC, m_dummyRC);
+	}
+
+	void OffscreenContext::ReleaseDummy()
+	{
+		if (m_dummyRC)
+		{
+			if (wglGetCurrentContext() == m_dummyRC)
+				wglMakeCurrent(NULL, NULL);
+			wglDeleteContext(m_dummyRC);
+			m_dummyRC = NULL;
+		}
+		if (m_dummyDC)
+		{
+			ReleaseDC(m_dummyWindow, m_dummyDC);
+			m_dummyDC = NULL;
+		}
+		if (m_dummyWindow)
+		{
+			DestroyWindow(m_dummyWindow);
+			m_dummyWindow = NULL;
+		}
+	}
+
+	bool OffscreenContext::Create(int width, int height)
+	{
+		Log::Write("Creating offscreen GL context...\n", ENGINE_LOG);
+
+		if (!CreateDummy())
+		{
+			Log::Write("Error creating offscreen GL context, no dummy context!\n", ENGINE_LOG);
+			ReleaseDummy();
+			return false;
+		}
+
+		ChoosePixelFormatARBProc choosePixelFormat = (ChoosePixelFormatARBProc)wglGetProcAddress("wglChoosePixelFormatARB");
+		CreatePbufferARBProc createPbuffer = (CreatePbufferARBProc)wglGetProcAddress("wglCreatePbufferARB");
+		GetPbufferDCARBProc getPbufferDC = (GetPbufferDCARBProc)wglGetProcAddress("wglGetPbufferDCARB");
+		m_releasePbufferDC = wglGetProcAddress("wglReleasePbufferDCARB");
+		m_destroyPbuffer = wglGetProcAddress("wglDestroyPbufferARB");
+
+		if (!choosePixelFormat || !createPbuffer || !getPbufferDC)
+		{
+			Log::Write("Error creating offscreen GL context, WGL_ARB_pbuffer is not supported!\n", ENGINE_LOG);
+			ReleaseDummy();
+			return false;
+		}
+
+		const int attribs[] =
+		{
+			WGL_DRAW_TO_PBUFFER_ARB, GL_TRUE,
+			WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
+			WGL_DOUBLE_BUFFER_ARB, GL_FALSE,
+			WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,
+			WGL_COLOR_BITS_ARB, 24,
+			WGL_ALPHA_BITS_ARB, 8,
+			WGL_DEPTH_BITS_ARB, 24,
+			0
+		};
+		const int pbufferAttribs[] = { 0 };
+
+		int format = 0;
+		UINT nFormats = 0;
+		if (!choosePixelFormat(m_dummyDC, attribs, NULL, 1, &format, &nFormats) || nFormats == 0)
+		{
+			Log::Write("Error creating offscreen GL context, no pbuffer pixel format!\n", ENGINE_LOG);
+			ReleaseDummy();
+			return false;
+		}
+
+		m_pbuffer = createPbuffer(m_dummyDC, format, width, height, pbufferAttribs);
+		if (m_pbuffer)
+		{
+			m_pbufferDC = getPbufferDC(m_pbuffer);
+			m_pbufferRC = wglCreateContext(m_pbufferDC);
+		}
+
+		bool current = m_pbufferRC != NULL && wglMakeCurrent(m_pbufferDC, m_pbufferRC);
+
+		// The pbuffer context stands alone, so the dummy is no longer needed
+		ReleaseDummy();
+
+		if (!current)
+		{
+			Log::Write("Error creating offscreen GL context, pbuffer creation failed!\n", ENGINE_LOG);
+			Release();
+			return false;
+		}
+
+		m_width = width;
+		m_height = height;
+		return true;
+	}
+
+	void OffscreenContext::Release()
+	{
+		if (m_pbufferRC)
+		{
+			if (wglGetCurrentContext() == m_pbufferRC)
+				wglMakeCurrent(NULL, NULL);
+			wglDeleteContext(m_pbufferRC);
+			m_pbufferRC = NULL;
+		}
+
+		if (m_pbuffer)
+		{
+			ReleasePbufferDCARBProc releasePbufferDC = (ReleasePbufferDCARBProc)m_releasePbufferDC;
+			DestroyPbufferARBProc destroyPbuffer = (DestroyPbufferARBProc)m_destroyPbuffer;
+			if (releasePbufferDC && m_pbufferDC)
+				releasePbufferDC(m_pbuffer, m_pbufferDC);
+			if (destroyPbuffer)
+				destroyPbuffer(m_pbuffer);
+			m_pbuffer = NULL;
+			m_pbufferDC = NULL;
+		}
+
+		ReleaseDummy();
+	}
+
+	bool OffscreenContext::IsValid() const
+	{
+		return m_pbufferRC != NULL;
+	}
+
+	int OffscreenContext::Width() const
+	{
+		return m_width;
+	}
+
+	int OffscreenContext::Height() const
+	{
+		return m_height;
+	}
+}
@@ -28,6 +28,25 @@ namespace Physics
 		m_aType = aType;
 	}
 
+	Actor::Actor(PxRigidActor* actor)
+	{
+		m_actor.dynamicActor = nullptr;
+		m_actor.staticActor = nullptr;
+		m_pose = actor->getGlobalPose();
+		m_density = DEFAULT_DENSITY; // Mass is already set
+
+		if (actor->is<PxRigidDynamic>())
+		{
+			m_aType = DynamicActor;
+			m_actor.dynamicActor = actor->is<PxRigidDynamic>();
+		}
+		else
+		{
+			m_aType = StaticActor;
+			m_actor.staticActor = actor->is<PxRigidStatic>();
+		}
+	}
+
 	Actor::Actor(const Actor& param)
 	{
 		if(param.m_actor.dynamicActor)
@@ -41,6 +60,7 @@ namespace Physics
 
 		m_density = param.m_density;
 		m_aType = param.m_aType;
+		m_texture = param.m_texture;
 	}
 
 	Actor& Actor::operator=(const Actor& param)
@@ -60,6 +80,7 @@ namespace Physics
 
 			m_density = param.m_density;
 			m_aType = param.m_aType;
+			m_texture = param.m_texture;
 			return *this;
 		}
 	}
@@ -77,6 +98,14 @@ namespace Physics
 		return m_actor;
 	}
 
+	PxRigidActor* Actor::GetRigidActor()
+	{
+		if (m_aType == DynamicActor)
+			return m_actor.dynamicActor;
+		else
+			return m_actor.staticActor;
+	}
+
 	Transform Actor::Pose()
 	{
 		if (m_actor.dynamicActor)
@@ -111,19 +140,17 @@ namespace Physics
 
 	void Actor::SetTexture(std::string dataPath)
 	{
-		m_texID = GameFramework::LoadTexture(dataPath);
-		if (m_texID != 0)
-			m_textured = true;
+		m_texture = GameFramework::TextureManager::AcquireAsync(dataPath);
 	}
 
 	bool Actor::IsTextured() const
 	{
-		return m_textured;
+		return TextureID() != 0;
 	}
 
 	unsigned int Actor::TextureID() const
 	{
-		return m_texID;
+		return m_texture ? m_texture->ID() : 0;
 	}
 
 	/*------------------------------------------------------------------------\
@@ -137,6 +164,17 @@ namespace Physics
 		m_aType = aType;
 	}
 
+	ShapeActor::ShapeActor(PxRigidActor* actor, Vec3 color) : Actor(actor)
+	{
+		m_shape = nullptr;
+		m_material = nullptr;
+		actor->getShapes(&m_shape, 1);
+		m_geometry = m_shape->getGeometry();
+		m_shape->getMaterials(&m_material, 1); // Released with this actor, as the copy a new actor makes would be
+		m_color = color;
+		actor->userData = &m_color;
+	}
+
 	ShapeActor::ShapeActor(const ShapeActor& param) :
 		Actor(param.m_pose, param.m_density, param.m_aType)
 	{
@@ -252,6 +290,25 @@ namespace Physics
 		m_color = color;
 	}
 		
+	CompoundShapeActor::CompoundShapeActor(PxRigidActor* actor, Vec3 color) : Actor(actor)
+	{
+		nShapes = actor->getNbShapes();
+		m_geometrys = new PxGeometryHolder[nShapes];
+		m_material = nullptr;
+		m_color = color;
+
+		for (int i = 0; i < nShapes; i++)
+		{
+			PxShape* shape = nullptr;
+			actor->getShapes(&shape, 1, i);
+			m_geometrys[i] = shape->getGeometry();
+			if (i == 0)
+				shape->getMaterials(&m_material, 1);
+		}
+
+		actor->userData = &m_color;
+	}
+
 	CompoundShapeActor::CompoundShapeActor(const CompoundShapeActor& param)
 	{
 		m_material = cpyMaterial(param.m_material);
@@ -315,6 +372,11 @@ namespace Physics
 		Create();
 	}
 
+	Box::Box(PxRigidActor* actor, const Vec3& color) : ShapeActor(actor, color)
+	{
+		m_dimensions = m_geometry.box().halfExtents;
+	}
+
 	Box::Box(const Box& param) : ShapeActor(param)
 	{
 		m_dimensions = param.m_dimensions; 
@@ -396,6 +458,22 @@ namespace Physics
 		Create();
 	}
 
+	ConvexMeshActor::ConvexMeshActor(PxConvexMesh* mesh, Transform pose, Fl32 density, const Vec3& color, PxMaterial* material, Vec3 scale, ActorType aType)
+		: ShapeActor(pose, density, material, color, aType)
+	{
+		m_scale = scale;
+		m_pose = m_pose * Transform(Quat(DEG2RAD(90), Vec3(1, 0, 0))); // Default Pose Rotation
+
+		m_geometry.storeAny(PxConvexMeshGeometry(mesh, PxMeshScale(m_scale, Quat::createIdentity())));
+
+		Create();
+	}
+
+	ConvexMeshActor::ConvexMeshActor(PxRigidActor* actor, const Vec3& color) : ShapeActor(actor, color)
+	{
+		m_scale = m_geometry.convexMesh().scale.scale;
+	}
+
 	ConvexMeshActor::ConvexMeshActor(const ConvexMeshActor& param) : ShapeActor(param)
 	{
 		m_scale = param.m_scale;
@@ -448,6 +526,16 @@ namespace Physics
 		return new ConvexMeshActor(VertexSet(verts, nVerts), pose, density, color, material, scale, aType);
 	}
 
+	PxConvexMeshDesc ConvexMeshActor::WedgeDesc()
+	{
+		return ConvexMeshDesc(wedge_verts, sizeof(wedge_verts) / sizeof(Vec3));
+	}
+
+	PxConvexMeshDesc ConvexMeshActor::PyramidDesc()
+	{
+		return ConvexMeshDesc(pyramid_verts, sizeof(pyramid_verts) / sizeof(Vec3));
+	}
+
 	ConvexMeshActor* ConvexMeshActor::CreateHexagon(Transform pose, Fl32 density, const Vec3& color, PxMaterial* material, Vec3 scale, ActorType aType)
 	{
 		int nVerts = 48;
@@ -0,0 +1,143 @@
+/*-------------------------------------------------------------------------\
+| File: COLLECTIONCACHE.CPP													|
+| Desc: Definitions for an on disk cache of PhysX objects, kept as a		|
+|		binary collection and deserialized in place.						|
+| Declaration File: COLLECTIONCACHE.H										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "CollectionCache.h"
+#include "fileUtil.h"
+#include <malloc.h>
+#include <fstream>
+
+namespace Physics
+{
+	static const unsigned int COLLECTION_CACHE_MAGIC = 0x43434250; // "PBCC"
+	static const unsigned int COLLECTION_CACHE_VERSION = 1;
+
+	// The collection starts here, so reading the file into an aligned block leaves it aligned for deserialization
+	static const unsigned int COLLECTION_OFFSET = PX_SERIAL_FILE_ALIGN;
+
+	/* Start of a cache file */
+	struct CollectionCacheHeader
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int physicsVersion;
+		unsigned int collectionSize;
+		unsigned long long key;
+	};
+
+	/*-------------------------------------------------------------------------\
+	|						COLLECTION CACHE DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	std::vector<void*> CollectionCache::m_blocks;
+
+	PxCollection* CollectionCache::Read(const std::string& path, unsigned long long key)
+	{
+		std::ifstream file(path.c_str(), std::ios::binary);
+		CollectionCacheHeader header;
+		if (!file || !file.read((char*)&header, sizeof(header)))
+			return nullptr;
+
+		if (header.magic != COLLECTION_CACHE_MAGIC || header.version != COLLECTION_CACHE_VERSION || header.physicsVersion != PX_PHYSICS_VERSION ||
+			header.key != key || header.collectionSize == 0)
+			return nullptr; // Stale
+
+		// Objects are deserialized into the block itself, so it is kept until they are released
+		void* block = _aligned_malloc(header.collectionSize, PX_SERIAL_FILE_ALIGN);
+		if (block == nullptr)
+			return nullptr;
+
+		PxCollection* collection = nullptr;
+		PxSerializationRegistry* registry = PxSerialization::createSerializationRegistry(*PHYSICS);
+		file.seekg(COLLECTION_OFFSET);
+		if (registry != nullptr && file.read((char*)block, header.collectionSize))
+			collection = PxSerialization::createCollectionFromBinary(block, *registry);
+		if (registry != nullptr)
+			registry->release();
+
+		if (collection == nullptr)
+		{
+			Log::Write(("Exc: Could not deserialize " + path + "\n").c_str(), ENGINE_LOG);
+			_aligned_free(block);
+			return nullptr;
+		}
+
+		m_blocks.push_back(block);
+		return collection;
+	}
+
+	bool CollectionCache::Write(const std::string& path, unsigned long long key, PxCollection& collection)
+	{
+		PxSerializationRegistry* registry = PxSerialization::createSerializationRegistry(*PHYSICS);
+		if (registry == nullptr)
+			return false;
+
+		PxSerialization::complete(collection, *registry);
+
+		PxDefaultMemoryOutputStream stream;
+		bool serialized = PxSerialization::isSerializable(collection, *registry) && PxSerialization::serializeCollectionToBinary(stream, collection, *registry);
+		registry->release();
+
+		if (!serialized)
+		{
+			Log::Write(("Exc: Could not serialize a collection to " + path + "\n").c_str(), ENGINE_LOG);
+			return false;
+		}
+
+		GameFramework::AtomicFile file(path);
+		if (!file.IsOpen())
+			return false;
+
+		CollectionCacheHeader header = { COLLECTION_CACHE_MAGIC, COLLECTION_CACHE_VERSION, PX_PHYSICS_VERSION, stream.getSize(), key };
+		static const char padding[COLLECTION_OFFSET] = { 0 };
+		file.Stream().write((const char*)&header, sizeof(header));
+		file.Stream().write(padding, COLLECTION_OFFSET - sizeof(header));
+		file.Stream().write((const char*)stream.getData(), stream.getSize());
+
+		return file.Commit();
+	}
+
+	void CollectionCache::ReleaseObjects(PxCollection& collection)
+	{
+		// Gathered first, as releasing an object leaves a dangling pointer in the collection
+		std::vector<PxJoint*> joints;
+		std::vector<PxRigidActor*> actors;
+		std::vector<PxBase*> resources;
+		for (PxU32 i = 0; i < collection.getNbObjects(); i++)
+		{
+			PxBase& object = collection.getObject(i);
+			if (object.is<PxJoint>())
+				joints.push_back(object.is<PxJoint>());
+			else if (object.is<PxRigidActor>())
+				actors.push_back(object.is<PxRigidActor>());
+			else if (object.is<PxMaterial>() || object.is<PxConvexMesh>())
+				resources.push_back(&object);
+		}
+
+		for (size_t i = 0; i < joints.size(); i++)
+			joints[i]->release();
+		for (size_t i = 0; i < actors.size(); i++)
+			actors[i]->release();
+		for (size_t i = 0; i < resources.size(); i++)
+			resources[i]->release();
+	}
+
+	void CollectionCache::Release()
+	{
+		for (size_t i = 0; i < m_blocks.size(); i++)
+			_aligned_free(m_blocks[i]);
+		m_blocks.clear();
+	}
+
+	void CollectionCache::Hash(unsigned long long& hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	}
+}
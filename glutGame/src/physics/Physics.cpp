@@ -6,6 +6,9 @@
 \-------------------------------------------------------------------------*/
 #include "physics\Physics.h"
 #include "Actors.h"
+#include "CollectionCache.h"
+#include <thread>
+#include <atomic>
 
 namespace Physics
 {
@@ -58,6 +61,7 @@ namespace Physics
 		Log::Write("Releasing PhysX Resources...\n", ENGINE_LOG);
 
 		PX_RELEASE(physics);
+		CollectionCache::Release();
 		PX_RELEASE(foundation);
 	}
 
@@ -131,19 +135,23 @@ namespace Physics
 	/* Create a Convex Mesh from the given vertices and scale */
 	PxConvexMesh* CreateConvexMesh(Vec3* const verts, const int& nVerts, const Vec3& scale)
 	{
-		PxConvexMeshDesc desc;
-		desc.points.count = nVerts;
-		desc.points.stride = sizeof(Vec3);
-
 		// Scale Vertices
 		for (int i = 0; i < nVerts; i++)
 			verts[i] = Vec3(verts[i].x * scale.x, verts[i].y * scale.y, verts[i].z * scale.z);
 
+		return Cook(ConvexMeshDesc(verts, nVerts));
+	}
+
+	/* Describes a convex mesh computed from the given vertices, which must outlive cooking */
+	PxConvexMeshDesc ConvexMeshDesc(const Vec3* verts, const int& nVerts)
+	{
+		PxConvexMeshDesc desc;
+		desc.points.count = nVerts;
+		desc.points.stride = sizeof(Vec3);
 		desc.points.data = verts;
 		desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 		desc.vertexLimit = VERTEX_LIMIT;
-
-		return Cook(desc);
+		return desc;
 	}
 
 	/* Cooks a given convex mesh description */
@@ -155,6 +163,47 @@ namespace Physics
 		return physics->createConvexMesh(input);
 	}
 
+	/* Cooks several descriptions concurrently, returning a mesh for each (NULL where cooking failed) */
+	std::vector<PxConvexMesh*> CookAll(const std::vector<PxConvexMeshDesc>& descs)
+	{
+		std::vector<PxDefaultMemoryOutputStream> streams(descs.size());
+		std::vector<char> cooked(descs.size(), false);
+
+		// Cooking calls are thread safe, so workers (and this thread) take descriptions in turn until none are left
+		std::atomic<size_t> next(0);
+		auto cookNext = [&]()
+		{
+			for (size_t i = next++; i < descs.size(); i = next++)
+				cooked[i] = PxGetCooking()->cookConvexMesh(descs[i], streams[i]);
+		};
+
+		unsigned int threads = std::thread::hardware_concurrency();
+		if (threads > descs.size())
+			threads = (unsigned int)descs.size();
+
+		std::vector<std::thread> workers;
+		for (unsigned int i = 1; i < threads; i++)
+			workers.push_back(std::thread(cookNext));
+		cookNext();
+		for (size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+
+		// Meshes are created here rather than on the workers, as they are registered with the physics object
+		std::vector<PxConvexMesh*> meshes(descs.size(), nullptr);
+		for (size_t i = 0; i < descs.size(); i++)
+		{
+			if (cooked[i])
+			{
+				PxDefaultMemoryInputData input(streams[i].getData(), streams[i].getSize());
+				meshes[i] = physics->createConvexMesh(input);
+			}
+			if (meshes[i] == nullptr)
+				Log::Write(("Err: Could not cook convex mesh " + std::to_string(i) + "!\n").c_str(), ENGINE_LOG);
+		}
+
+		return meshes;
+	}
+
 	/*-------------------------------------------------------------------------\
 	|						EVENT CALLBACK DEFINITIONS							|
 	\-------------------------------------------------------------------------*/
@@ -201,6 +250,7 @@ namespace Physics
 		m_scene = nullptr;
 		m_pause = false;
 		m_eventCallback = nullptr;
+		m_generation = 0;
 	}
 
 	Scene::~Scene()
@@ -292,5 +342,33 @@ namespace Physics
 			m_scene->addActor(*actor->Get().dynamicActor);
 		else
 			m_scene->addActor(*actor->Get().staticActor);
+		m_generation++;
+	}
+
+	void Scene::Add(const std::vector<Actor*>& actors)
+	{
+		Log::Write(("\tAdding " + std::to_string(actors.size()) + " Actors to scene...\n").c_str(), ENGINE_LOG);
+
+		std::vector<PxActor*> batch;
+		batch.reserve(actors.size());
+		for (std::vector<Actor*>::const_iterator iter = actors.begin(); iter != actors.end(); iter++)
+		{
+			Actor* actor = *iter;
+			if (actor->Get().staticActor == nullptr && actor->Get().dynamicActor == nullptr)
+				actor->Create();
+			if (actor->Get().dynamicActor)
+				batch.push_back(actor->Get().dynamicActor);
+			else
+				batch.push_back(actor->Get().staticActor);
+		}
+
+		if (!batch.empty())
+			m_scene->addActors(&batch[0], batch.size());
+		m_generation++;
 	}
-}
\ No newline at end of file
+
+	unsigned int Scene::Generation() const
+	{
+		return m_generation;
+	}
+}
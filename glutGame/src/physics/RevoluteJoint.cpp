@@ -15,6 +15,16 @@ namespace Physics
 		m_joint->setDriveForceLimit(5);
 	}
 
+	RevoluteJoint::RevoluteJoint(PxRevoluteJoint* joint)
+	{
+		m_joint = joint;
+	}
+
+	PxRevoluteJoint* RevoluteJoint::Get() const
+	{
+		return m_joint;
+	}
+
 	void RevoluteJoint::DriveVelocity(Fl32 value)
 	{
 		m_joint->setDriveVelocity(value);
@@ -1,7 +1,7 @@
 /*
 File: SOUND.CPP
 Author: Henri Keeble
-Desc: Defines a simple sample class using BASS.
+Desc: Defines a simple sample class, played through the audio thread.
 */
 #include "sample.h"
 
@@ -12,15 +12,15 @@ namespace GameFramework
 		sound = 0;
 	}
 	
-	Sample::Sample(const char* filename)
+	Sample::Sample(const char* filename, unsigned int voices)
 	{
-		Load(filename);
+		sound = 0;
+		Load(filename, voices);
 	}
 
 	Sample::Sample(const Sample& param)
 	{
 		this->sound = param.sound;
-		this->channel = param.channel;
 	}
 
 	Sample& Sample::operator=(const Sample& param)
@@ -30,7 +30,6 @@ namespace GameFramework
 		else
 		{
 			this->sound = param.sound;
-			this->channel = param.channel;
 			return *this;
 		}
 	}
@@ -44,11 +43,7 @@ namespace GameFramework
 	{
 		// If no sound, do not attempt to play
 		if (sound != 0)
-		{
-			if (BASS_ChannelIsActive(GetChannel()) != BASS_ACTIVE_PLAYING) // Only play if not already playing
-				channel = BASS_SampleGetChannel(sound, false); // Create channel and play
-			BASS_ChannelPlay(channel, false);
-		}
+			Audio::Play(sound);
 		else
 			Log::Write("Error playing sound file, sound not loaded!\n", ENGINE_LOG);
 	}
@@ -56,30 +51,23 @@ namespace GameFramework
 	void Sample::Stop()
 	{
 		if (sound != 0)
-			BASS_ChannelStop(channel);
+			Audio::Stop(sound);
 		else
 			Log::Write("Error playing sound file, sound not loaded!\n", ENGINE_LOG);
 	}
 
-	HSAMPLE Sample::GetSample() const
+	SoundID Sample::ID() const
 	{
 		return sound;
 	}
 
-	HCHANNEL Sample::GetChannel() const
-	{
-		return channel;
-	}
-
-	void Sample::Load(const char* filename)
+	void Sample::Load(const char* filename, unsigned int voices)
 	{
 		if (sound != 0) // If playing, stop
-			BASS_SampleStop(sound);
-
-		// Load the sample with the given file name
-		sound = BASS_SampleLoad(false, filename, 0, 0, 1, BASS_SAMPLE_OVER_POS);
+			Audio::Stop(sound);
 
-		// Report of error in loading
+		// Loaded on the audio thread, which reports a file that can't be read
+		sound = Audio::LoadSample(filename, voices);
 		if (sound == 0)
 		{
 			Log::Write("Sound ", ENGINE_LOG);
@@ -87,4 +75,4 @@ namespace GameFramework
 			Log::Write(" not loaded correctly!\n", ENGINE_LOG);
 		}
 	}
-}
\ No newline at end of file
+}
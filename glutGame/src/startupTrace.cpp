@@ -0,0 +1,245 @@
+/*-------------------------------------------------------------------------\
+| File: STARTUPTRACE.CPP													|
+| Desc: Provides definitions for timing startup phases, a report of them	|
+|		in Chrome trace event format, and a time to first frame				|
+|		benchmark run across fresh processes.								|
+| Declaration File: STARTUPTRACE.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "startupTrace.h"
+#include "log.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace GameFramework
+{
+	static unsigned long long FileTimeValue(const FILETIME& time)
+	{
+		return ((unsigned long long)time.dwHighDateTime << 32) | time.dwLowDateTime;
+	}
+
+	typedef void (WINAPI *GetSystemTimePreciseAsFileTimeProc)(FILETIME* time);
+
+	// Milliseconds between process creation and now, covering what runs before main (DLL loading, static initialization).
+	// Now is read from the precise system clock (Windows 8 and later), as the regular one only ticks every ~15.6ms.
+	static double ProcessAge()
+	{
+		FILETIME creation, exit, kernel, user, now;
+		if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+			return 0;
+
+		GetSystemTimePreciseAsFileTimeProc getPreciseTime =
+			(GetSystemTimePreciseAsFileTimeProc)GetProcAddress(GetModuleHandleA("kernel32.dll"), "GetSystemTimePreciseAsFileTime");
+		if (getPreciseTime != NULL)
+			getPreciseTime(&now);
+		else
+			GetSystemTimeAsFileTime(&now);
+		return (FileTimeValue(now) - FileTimeValue(creation)) / 10000.0; // 100ns units
+	}
+
+	// Process age when the trace clock starts
+	static const double gOriginAge = ProcessAge();
+	static const FrameClockType::time_point gOrigin = FrameClockType::now();
+
+	// Path of a file in the log directory (beside the executable)
+	static std::string LogPath(const char* fileName)
+	{
+		const char* directory = Log::GetWorkingDir();
+		return std::string(directory ? directory : "") + fileName;
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							STARTUP TRACE DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	std::mutex StartupTrace::m_mutex;
+	std::vector<TraceEvent> StartupTrace::m_events;
+	double StartupTrace::m_firstFrame = -1;
+	bool StartupTrace::m_written = false;
+
+	double StartupTrace::Elapsed()
+	{
+		return gOriginAge + std::chrono::duration<double, std::milli>(FrameClockType::now() - gOrigin).count();
+	}
+
+	void StartupTrace::Record(const std::string& name, double start, double end)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_written)
+			return;
+
+		TraceEvent e = { name, start, end - start, GetCurrentThreadId() };
+		m_events.push_back(e);
+	}
+
+	void StartupTrace::MarkFirstFrame()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_firstFrame >= 0)
+				return;
+			m_firstFrame = Elapsed();
+		}
+
+		Log::Write(("Time to first frame: " + std::to_string(m_firstFrame) + "ms\n").c_str(), ENGINE_LOG);
+		Write();
+	}
+
+	double StartupTrace::FirstFrame()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_firstFrame;
+	}
+
+	void StartupTrace::Write()
+	{
+		std::vector<TraceEvent> events;
+		double firstFrame;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_written)
+				return;
+			m_written = true;
+			events.swap(m_events);
+			firstFrame = m_firstFrame;
+		}
+
+		std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) { return a.start < b.start; });
+
+		// Complete ("X") events, times in microseconds
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(0);
+		ss << "{\n\t\"firstFrameMs\": " << std::setprecision(3) << firstFrame << std::setprecision(0) << ",\n";
+		ss << "\t\"traceEvents\": [\n";
+		for (size_t i = 0; i < events.size(); i++)
+		{
+			std::string name;
+			for (size_t c = 0; c < events[i].name.size(); c++)
+			{
+				char ch = events[i].name[c];
+				if (ch == '"' || ch == '\\')
+					name += '\\';
+				name += ch;
+			}
+
+			ss << "\t\t{ \"name\": \"" << name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << events[i].thread
+				<< ", \"ts\": " << events[i].start * 1000.0 << ", \"dur\": " << events[i].duration * 1000.0 << " },\n";
+		}
+
+		// Instant event marking the first frame, which also saves special casing the last comma
+		ss << "\t\t{ \"name\": \"First frame\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, \"tid\": 0, \"ts\": "
+			<< (firstFrame >= 0 ? firstFrame * 1000.0 : 0.0) << " }\n";
+		ss << "\t]\n}\n";
+
+		std::ofstream file(LogPath(STARTUP_TRACE_LOG).c_str());
+		file << ss.str();
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							TRACE SCOPE DEFINITIONS							|
+	\-------------------------------------------------------------------------*/
+	TraceScope::TraceScope(const std::string& name)
+		: m_name(name)
+	{
+		m_start = StartupTrace::Elapsed();
+	}
+
+	TraceScope::~TraceScope()
+	{
+		StartupTrace::Record(m_name, m_start, StartupTrace::Elapsed());
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							STARTUP BENCHMARK DEFINITIONS					|
+	\-------------------------------------------------------------------------*/
+	// Launches one probe, returning its time to first frame, or a negative value on failure
+	static double RunProbe(const std::string& executable, const std::string& probeArgs)
+	{
+		std::string probeLog = LogPath(STARTUP_PROBE_LOG);
+		DeleteFileA(probeLog.c_str());
+
+		std::string command = "\"" + executable + "\" " + probeArgs;
+		STARTUPINFOA startup = { sizeof(STARTUPINFOA) };
+		PROCESS_INFORMATION process;
+		if (!CreateProcessA(NULL, &command[0], NULL, NULL, FALSE, 0, NULL, NULL, &startup, &process))
+			return -1;
+
+		bool finished = WaitForSingleObject(process.hProcess, STARTUP_PROBE_TIMEOUT) == WAIT_OBJECT_0;
+		if (!finished)
+			TerminateProcess(process.hProcess, 1);
+
+		// A probe that exits with a failure status (e.g. no playable table) failed, even if it got as far as a frame
+		DWORD status = 1;
+		if (finished && (!GetExitCodeProcess(process.hProcess, &status) || status != 0))
+			finished = false;
+		CloseHandle(process.hThread);
+		CloseHandle(process.hProcess);
+
+		double ms = -1;
+		std::ifstream result(probeLog.c_str());
+		if (!finished || !(result >> ms))
+			return -1;
+		return ms;
+	}
+
+	int StartupBenchmark::Run(const std::string& probeArgs, int runs)
+	{
+		char executable[MAX_PATH];
+		GetModuleFileNameA(NULL, executable, MAX_PATH);
+
+		std::stringstream report;
+		report << std::fixed << std::setprecision(3);
+		report << "Startup benchmark - time to first frame over " << runs << " runs\n";
+
+		std::vector<double> times;
+		for (int i = 0; i < runs; i++)
+		{
+			double ms = RunProbe(executable, probeArgs);
+			if (ms < 0)
+			{
+				report << "Run " << i + 1 << " failed\n";
+				Log::Write(report.str().c_str(), STARTUP_BENCH_LOG);
+				Log::Write(report.str().c_str(), ENGINE_LOG);
+				return 2;
+			}
+
+			report << "Run " << i + 1 << ", " << ms << "ms\n";
+			times.push_back(ms);
+		}
+
+		if (times.empty())
+			return 2;
+
+		std::sort(times.begin(), times.end());
+		double median = times[times.size() / 2];
+		report << "Median, " << median << "ms\n";
+
+		int result = 0;
+		double baseline = 0;
+		std::ifstream baselineFile(LogPath(STARTUP_BASELINE).c_str());
+		if (baselineFile >> baseline && baseline > 0)
+		{
+			double limit = baseline * STARTUP_REGRESSION_THRESHOLD;
+			report << "Baseline, " << baseline << "ms (limit " << limit << "ms)\n";
+			if (median > limit)
+			{
+				report << "FAILED - time to first frame regressed by " << (median / baseline - 1.0) * 100.0 << "%\n";
+				result = 1;
+			}
+			else
+				report << "Passed\n";
+		}
+		else
+		{
+			// First run on this machine sets the baseline
+			std::ofstream newBaseline(LogPath(STARTUP_BASELINE).c_str());
+			newBaseline << median << "\n";
+			report << "No baseline, recorded " << median << "ms\n";
+		}
+
+		Log::Write(report.str().c_str(), STARTUP_BENCH_LOG);
+		Log::Write(report.str().c_str(), ENGINE_LOG);
+		return result;
+	}
+}
@@ -0,0 +1,183 @@
+/*-------------------------------------------------------------------------\
+| File: STATEIMAGES.CPP														|
+| Desc: Provides definitions for a set of full screen images bound to		|
+|		game states, loaded when their state shows and evicted under a		|
+|		texture memory budget.												|
+| Declaration File: STATEIMAGES.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "stateImages.h"
+
+namespace GameFramework
+{
+	StateImages::StateImages(unsigned int budget)
+	{
+		m_budget = budget;
+		m_showCount = 0;
+	}
+
+	bool StateImages::IsBound(const Screen& screen, int state) const
+	{
+		for (size_t i = 0; i < screen.states.size(); i++)
+		{
+			if (screen.states[i] == state)
+				return true;
+		}
+		return false;
+	}
+
+	unsigned int StateImages::Committed(const Screen& screen) const
+	{
+		if (!screen.image.IsAcquired())
+			return 0;
+		return screen.image.Bytes() != 0 ? screen.image.Bytes() : screen.bytes;
+	}
+
+	bool StateImages::IsLoadingUnknown() const
+	{
+		for (size_t i = 0; i < m_screens.size(); i++)
+		{
+			const Screen& screen = m_screens[i];
+			if (screen.image.IsAcquired() && !screen.image.IsLoaded() && screen.bytes == 0)
+				return true;
+		}
+		return false;
+	}
+
+	void StateImages::Bind(int state, const std::string& fileName)
+	{
+		for (size_t i = 0; i < m_screens.size(); i++)
+		{
+			if (m_screens[i].fileName == fileName)
+			{
+				m_screens[i].states.push_back(state);
+				return;
+			}
+		}
+
+		Screen screen;
+		screen.fileName = fileName;
+		screen.states.push_back(state);
+		screen.bytes = 0;
+		screen.lastShown = 0;
+		m_screens.push_back(screen);
+	}
+
+	void StateImages::Link(int from, int to)
+	{
+		m_transitions.push_back(std::make_pair(from, to));
+	}
+
+	void StateImages::SetBudget(unsigned int bytes)
+	{
+		m_budget = bytes;
+	}
+
+	unsigned int StateImages::Budget() const
+	{
+		return m_budget;
+	}
+
+	void StateImages::Show(int state)
+	{
+		m_showCount++;
+
+		for (size_t i = 0; i < m_screens.size(); i++)
+		{
+			Screen& screen = m_screens[i];
+			if (IsBound(screen, state))
+			{
+				if (!screen.image.IsAcquired())
+					screen.image = Image(screen.fileName, true);
+				screen.lastShown = m_showCount;
+			}
+
+			// Sizes are remembered after eviction, so prefetching knows whether an image will fit
+			if (screen.image.Bytes() != 0)
+				screen.bytes = screen.image.Bytes();
+		}
+
+		Prefetch(state);
+		Evict(state);
+	}
+
+	void StateImages::Prefetch(int state)
+	{
+		// Images already loading count at their known size, so one pass can't fetch more than the budget holds
+		unsigned int committed = ResidentBytes();
+		bool loadingUnknown = IsLoadingUnknown();
+
+		for (size_t t = 0; t < m_transitions.size(); t++)
+		{
+			if (m_transitions[t].first != state)
+				continue;
+
+			for (size_t i = 0; i < m_screens.size(); i++)
+			{
+				Screen& screen = m_screens[i];
+				if (screen.image.IsAcquired() || !IsBound(screen, m_transitions[t].second))
+					continue;
+
+				// An image that has never loaded is fetched while there is any room, one at a time, so its size can be learned
+				if (screen.bytes == 0)
+				{
+					if (loadingUnknown || committed >= m_budget)
+						continue;
+					loadingUnknown = true;
+				}
+				else if (committed + screen.bytes > m_budget)
+					continue;
+
+				committed += screen.bytes;
+				screen.image = Image(screen.fileName, true);
+			}
+		}
+	}
+
+	void StateImages::Evict(int state)
+	{
+		while (ResidentBytes() > m_budget)
+		{
+			// The least recently shown image not bound to the state showing (prefetched images have never been shown, so go first)
+			Screen* oldest = nullptr;
+			for (size_t i = 0; i < m_screens.size(); i++)
+			{
+				Screen& screen = m_screens[i];
+				if (screen.image.IsAcquired() && !IsBound(screen, state) && (oldest == nullptr || screen.lastShown < oldest->lastShown))
+					oldest = &screen;
+			}
+
+			if (oldest == nullptr)
+				break; // The state's own images are over the budget
+
+			oldest->image.Release();
+		}
+	}
+
+	void StateImages::Render(int state)
+	{
+		for (size_t i = 0; i < m_screens.size(); i++)
+		{
+			if (IsBound(m_screens[i], state))
+				m_screens[i].image.Render();
+		}
+	}
+
+	bool StateImages::IsLoaded(int state) const
+	{
+		for (size_t i = 0; i < m_screens.size(); i++)
+		{
+			if (IsBound(m_screens[i], state) && !m_screens[i].image.IsLoaded())
+				return false;
+		}
+		return true;
+	}
+
+	unsigned int StateImages::ResidentBytes() const
+	{
+		unsigned int bytes = 0;
+		for (size_t i = 0; i < m_screens.size(); i++)
+			bytes += Committed(m_screens[i]);
+		return bytes;
+	}
+}
@@ -0,0 +1,217 @@
+/*-------------------------------------------------------------------------\
+| File: TEXTURECACHE.CPP													|
+| Desc: Provides definitions for an on disk cache of compressed mip			|
+|		chains, so textures SOIL has mipmapped and DXT compressed once		|
+|		can be uploaded directly on later runs.								|
+| Declaration File: TEXTURECACHE.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "textureCache.h"
+#include "loadImage.h"
+#include "fileUtil.h"
+#include <Windows.h>
+#include <fstream>
+#include <cstdio>
+#include <cctype>
+
+namespace GameFramework
+{
+	// GL 1.2/1.3 tokens, not in the Windows SDK headers
+	static const GLenum TEXTURE_COMPRESSED_IMAGE_SIZE = 0x86A0;
+	static const GLenum TEXTURE_COMPRESSED = 0x86A1;
+	static const GLenum CLAMP_TO_EDGE = 0x812F;
+
+	typedef void (WINAPI *CompressedTexImage2DProc)(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+		GLint border, GLsizei imageSize, const void* data);
+	typedef void (WINAPI *GetCompressedTexImageProc)(GLenum target, GLint level, void* img);
+
+	static const unsigned int CACHE_MAGIC = 0x43544250; // "PBTC"
+	static const unsigned int CACHE_VERSION = 1;
+
+	/* Fixed size start of an entry. The source path follows, then each level as width, height, size and data. */
+	struct CacheHeader
+	{
+		unsigned int magic;
+		unsigned int version;
+		unsigned int flags;
+		unsigned int internalFormat;
+		unsigned long long sourceTime;
+		unsigned int levelCount;
+		unsigned int pathLength;
+	};
+
+	// Last write time of the image a texture came from, as packed when it is read from the asset archive
+	static unsigned long long SourceTime(const std::string& dataPath)
+	{
+		AssetView view;
+		if (AssetArchive::Find("img", dataPath.c_str(), view))
+			return view.modified;
+		return ModifiedTime(ImagePath(dataPath));
+	}
+
+	// Entry file for an image, named by a hash of its path (FNV-1a)
+	static std::string EntryPath(const std::string& dataPath)
+	{
+		unsigned long long hash = 14695981039346656037ull;
+		for (size_t i = 0; i < dataPath.size(); i++)
+		{
+			hash ^= (unsigned char)tolower(dataPath[i]);
+			hash *= 1099511628211ull;
+		}
+
+		char name[32];
+		sprintf_s(name, "%016llx.ptc", hash);
+
+		std::string path = GetCurrentDir();
+		path.append(TEXTURE_CACHE_DIR "\\");
+		return path + name;
+	}
+
+	bool CachedTexture::IsEmpty() const
+	{
+		return levels.empty();
+	}
+
+	bool TextureCache::Read(const std::string& dataPath, unsigned int flags, CachedTexture& texture)
+	{
+		texture = CachedTexture();
+
+		std::ifstream file(EntryPath(dataPath).c_str(), std::ios::binary);
+		if (!file)
+			return false;
+
+		CacheHeader header;
+		if (!file.read((char*)&header, sizeof(header)) || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+			header.flags != flags || header.levelCount == 0 || header.pathLength != dataPath.size())
+			return false;
+
+		// The path guards against hash collisions
+		std::string path(header.pathLength, '\0');
+		if (!file.read(&path[0], path.size()) || path != dataPath)
+			return false;
+
+		unsigned long long sourceTime = SourceTime(dataPath);
+		if (sourceTime == 0 || sourceTime != header.sourceTime)
+			return false;
+
+		texture.internalFormat = header.internalFormat;
+		texture.levels.resize(header.levelCount);
+		for (unsigned int i = 0; i < header.levelCount; i++)
+		{
+			CachedLevel& level = texture.levels[i];
+			unsigned int size = 0;
+			if (!file.read((char*)&level.width, sizeof(int)) || !file.read((char*)&level.height, sizeof(int)) ||
+				!file.read((char*)&size, sizeof(size)))
+				break;
+
+			level.data.resize(size);
+			if (size == 0 || !file.read((char*)&level.data[0], size))
+				break;
+
+			if (i + 1 == header.levelCount)
+				return true;
+		}
+
+		// Truncated entry
+		texture = CachedTexture();
+		return false;
+	}
+
+	unsigned int TextureCache::Upload(const CachedTexture& texture)
+	{
+		CompressedTexImage2DProc compressedTexImage2D = (CompressedTexImage2DProc)wglGetProcAddress("glCompressedTexImage2D");
+		if (compressedTexImage2D == NULL || texture.IsEmpty())
+			return 0;
+
+		// Errors left by earlier calls would otherwise fail this upload
+		while (glGetError() != GL_NO_ERROR)
+			;
+
+		GLuint id = 0;
+		glGenTextures(1, &id);
+		glBindTexture(GL_TEXTURE_2D, id);
+
+		for (size_t i = 0; i < texture.levels.size(); i++)
+		{
+			const CachedLevel& level = texture.levels[i];
+			compressedTexImage2D(GL_TEXTURE_2D, i, texture.internalFormat, level.width, level.height, 0, level.data.size(), &level.data[0]);
+		}
+
+		// As SOIL leaves the textures it creates
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if (glGetError() != GL_NO_ERROR)
+		{
+			glDeleteTextures(1, &id);
+			return 0;
+		}
+		return id;
+	}
+
+	bool TextureCache::Write(const std::string& dataPath, unsigned int flags, unsigned int textureID)
+	{
+		GetCompressedTexImageProc getCompressedTexImage = (GetCompressedTexImageProc)wglGetProcAddress("glGetCompressedTexImage");
+		unsigned long long sourceTime = SourceTime(dataPath);
+		if (getCompressedTexImage == NULL || sourceTime == 0 || textureID == 0)
+			return false;
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		GLint compressed = 0, internalFormat = 0;
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, TEXTURE_COMPRESSED, &compressed);
+		glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+
+		CachedTexture texture;
+		texture.internalFormat = internalFormat;
+		for (GLint level = 0; compressed; level++)
+		{
+			CachedLevel data;
+			GLint size = 0;
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &data.width);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &data.height);
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+			if (data.width == 0 || data.height == 0 || size <= 0)
+				break; // Past the end of the chain
+
+			data.data.resize(size);
+			getCompressedTexImage(GL_TEXTURE_2D, level, &data.data[0]);
+			texture.levels.push_back(data);
+
+			if (data.width == 1 && data.height == 1)
+				break;
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if (texture.IsEmpty())
+			return false;
+
+		std::string directory = GetCurrentDir();
+		directory.append(TEXTURE_CACHE_DIR);
+		CreateDirectoryA(directory.c_str(), NULL);
+
+		AtomicFile entry(EntryPath(dataPath));
+		if (!entry.IsOpen())
+			return false;
+
+		std::ofstream& file = entry.Stream();
+		CacheHeader header = { CACHE_MAGIC, CACHE_VERSION, flags, texture.internalFormat, sourceTime,
+			(unsigned int)texture.levels.size(), (unsigned int)dataPath.size() };
+		file.write((const char*)&header, sizeof(header));
+		file.write(dataPath.c_str(), dataPath.size());
+
+		for (size_t i = 0; i < texture.levels.size(); i++)
+		{
+			const CachedLevel& level = texture.levels[i];
+			unsigned int size = level.data.size();
+			file.write((const char*)&level.width, sizeof(int));
+			file.write((const char*)&level.height, sizeof(int));
+			file.write((const char*)&size, sizeof(size));
+			file.write((const char*)&level.data[0], size);
+		}
+
+		return entry.Commit();
+	}
+}
@@ -0,0 +1,172 @@
+/*-------------------------------------------------------------------------\
+| File: TEXTUREMANAGER.CPP													|
+| Desc: Provides definitions for a cache of textures keyed by image path,	|
+|		handing out shared handles so each image is loaded once.			|
+| Declaration File: TEXTUREMANAGER.H										|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "textureManager.h"
+#include "loadImage.h"
+#include "startupTrace.h"
+
+namespace GameFramework
+{
+	std::mutex TextureManager::m_mutex;
+	std::map<std::string, std::weak_ptr<TextureResource> > TextureManager::m_textures;
+	std::vector<unsigned int> TextureManager::m_released;
+	ImageDecoder TextureManager::m_decoder;
+
+	/*-------------------------------------------------------------------------\
+	|							TEXTURE RESOURCE DEFINITIONS					|
+	\-------------------------------------------------------------------------*/
+	TextureResource::TextureResource(const std::string& path)
+		: m_path(path), m_id(0), m_bytes(0), m_loaded(false)
+	{
+
+	}
+
+	TextureResource::TextureResource(const std::string& path, unsigned int id)
+		: m_path(path), m_id(id), m_bytes(TextureMemory(id)), m_loaded(true)
+	{
+
+	}
+
+	TextureResource::~TextureResource()
+	{
+		std::lock_guard<std::mutex> lock(TextureManager::m_mutex);
+
+		// A new load of the same path may already have replaced this entry
+		std::map<std::string, std::weak_ptr<TextureResource> >::iterator entry = TextureManager::m_textures.find(m_path);
+		if (entry != TextureManager::m_textures.end() && entry->second.expired())
+			TextureManager::m_textures.erase(entry);
+
+		if (m_id != 0)
+			TextureManager::m_released.push_back(m_id);
+	}
+
+	unsigned int TextureResource::ID() const
+	{
+		return m_id;
+	}
+
+	const std::string& TextureResource::Path() const
+	{
+		return m_path;
+	}
+
+	unsigned int TextureResource::Bytes() const
+	{
+		return m_bytes;
+	}
+
+	bool TextureResource::IsLoaded() const
+	{
+		return m_loaded;
+	}
+
+	void TextureResource::SetLoaded(unsigned int id)
+	{
+		m_id = id;
+		m_bytes = TextureMemory(id);
+		m_loaded = true;
+	}
+
+	/*-------------------------------------------------------------------------\
+	|							TEXTURE MANAGER DEFINITIONS						|
+	\-------------------------------------------------------------------------*/
+	TextureHandle TextureManager::Acquire(const std::string& dataPath)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			TextureHandle texture = m_textures[dataPath].lock();
+			if (texture)
+				return texture;
+		}
+
+		// Failed loads are cached too, so a missing image is only reported once while it is in use
+		TextureHandle texture = std::make_shared<TextureResource>(dataPath, LoadTexture(dataPath));
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_textures[dataPath] = texture;
+		return texture;
+	}
+
+	TextureHandle TextureManager::AcquireAsync(const std::string& dataPath)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		TextureHandle texture = m_textures[dataPath].lock();
+		if (texture)
+			return texture;
+
+		texture = std::make_shared<TextureResource>(dataPath);
+		m_textures[dataPath] = texture;
+
+		if (!m_decoder.IsRunning())
+			m_decoder.Start();
+		m_decoder.Queue(dataPath);
+		return texture;
+	}
+
+	void TextureManager::Update(unsigned int maxUploads)
+	{
+		std::vector<unsigned int> released;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			released.swap(m_released);
+		}
+
+		if (!released.empty())
+			glDeleteTextures(released.size(), &released[0]);
+
+		DecodedImage image;
+		for (unsigned int uploads = 0; (maxUploads == 0 || uploads < maxUploads) && m_decoder.Poll(image); uploads++)
+		{
+			TextureHandle texture;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::map<std::string, std::weak_ptr<TextureResource> >::iterator entry = m_textures.find(image.path);
+				if (entry != m_textures.end())
+					texture = entry->second.lock();
+			}
+
+			// Every handle was dropped while it decoded
+			if (!texture || texture->IsLoaded())
+			{
+				image.Free();
+				continue;
+			}
+
+			TraceScope scope("Upload " + image.path);
+
+			if (!image.cached.IsEmpty())
+			{
+				unsigned int id = UploadTexture(image.cached);
+				if (id != 0)
+				{
+					texture->SetLoaded(id);
+					continue;
+				}
+
+				// The driver rejected the cached blocks, fall back to decoding
+				image.pixels = DecodeImage(image.path, &image.width, &image.height, &image.channels);
+			}
+
+			if (image.pixels == NULL)
+			{
+				std::string s = "\n\n---- SOIL ERROR ----\nFilename: " + ImagePath(image.path) + "\nSOIL Message: Image could not be decoded\n\n";
+				Log::Write(s.c_str(), ENGINE_LOG);
+				texture->SetLoaded(0);
+				continue;
+			}
+
+			texture->SetLoaded(UploadTexture(image.pixels, image.width, image.height, image.channels, image.path));
+			image.Free();
+		}
+	}
+
+	void TextureManager::Shutdown()
+	{
+		m_decoder.Stop();
+	}
+}
@@ -35,7 +35,7 @@ namespace GameFramework
 
 	void Timer::Set(const int& hours, const int& minutes, const double& seconds, const double& milliseconds)
 	{
-		currentMilliseconds = ((hours * 60) * 60) + (minutes * 60) + (seconds * 1000) + milliseconds;
+		currentMilliseconds = (hours * 3600000.0) + (minutes * 60000.0) + (seconds * 1000) + milliseconds;
 	}
 
 	void Timer::Reset()
@@ -45,7 +45,7 @@ namespace GameFramework
 
 	void Timer::Update(double deltaTime)
 	{
-		currentMilliseconds += deltaTime;
+		currentMilliseconds += deltaTime * 1000;
 	}
 
 	double Timer::Milliseconds()
@@ -55,7 +55,7 @@ namespace GameFramework
 
 	double Timer::Seconds()
 	{
-		return currentMilliseconds * 1000;
+		return currentMilliseconds / 1000;
 	}
 
 	int Timer::Minutes()
@@ -0,0 +1,263 @@
+/*-------------------------------------------------------------------------\
+| File: WAVAUDIO.CPP														|
+| Desc: Provides definitions for an audio backend mixing everything it		|
+|		plays into a WAV file, for checking a run's audio offline.			|
+| Declaration File: WAVAUDIO.H												|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "wavAudio.h"
+#include "assetArchive.h"
+#include "log.h"
+#include <cstring>
+#include <iterator>
+
+namespace GameFramework
+{
+	/* Canonical 44 byte header of a PCM WAV file */
+	struct WavHeader
+	{
+		char riff[4];
+		unsigned int riffSize;
+		char wave[4];
+		char fmt[4];
+		unsigned int fmtSize;
+		unsigned short format;
+		unsigned short channels;
+		unsigned int rate;
+		unsigned int byteRate;
+		unsigned short blockAlign;
+		unsigned short bits;
+		char data[4];
+		unsigned int dataSize;
+	};
+
+	static unsigned int ReadU32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+	static unsigned short ReadU16(const unsigned char* p) { return (unsigned short)(p[0] | (p[1] << 8)); }
+
+	// Reads one channel of one source frame as 16 bit
+	static int SourceSample(const unsigned char* data, unsigned int frame, unsigned int channel, unsigned int channels, unsigned int bits)
+	{
+		if (bits == 8)
+			return ((int)data[frame * channels + channel] - 128) << 8;
+		return (short)ReadU16(data + (frame * channels + channel) * 2);
+	}
+
+	// Decodes a PCM WAV file into interleaved output frames, resampled linearly. Returns false if it isn't 8 or 16 bit PCM.
+	static bool DecodeWav(const unsigned char* file, size_t size, std::vector<short>& frames)
+	{
+		if (size < 12 || memcmp(file, "RIFF", 4) != 0 || memcmp(file + 8, "WAVE", 4) != 0)
+			return false;
+
+		unsigned int format = 0, channels = 0, rate = 0, bits = 0;
+		const unsigned char* data = nullptr;
+		unsigned int dataSize = 0;
+
+		// Chunks are word aligned
+		for (size_t offset = 12; offset + 8 <= size;)
+		{
+			unsigned int chunkSize = ReadU32(file + offset + 4);
+			const unsigned char* chunk = file + offset + 8;
+			if (chunkSize > size - offset - 8)
+				chunkSize = (unsigned int)(size - offset - 8);
+
+			if (memcmp(file + offset, "fmt ", 4) == 0 && chunkSize >= 16)
+			{
+				format = ReadU16(chunk);
+				channels = ReadU16(chunk + 2);
+				rate = ReadU32(chunk + 4);
+				bits = ReadU16(chunk + 14);
+			}
+			else if (memcmp(file + offset, "data", 4) == 0)
+			{
+				data = chunk;
+				dataSize = chunkSize;
+			}
+
+			offset += 8 + chunkSize + (chunkSize & 1);
+		}
+
+		if (format != 1 || (channels != 1 && channels != 2) || (bits != 8 && bits != 16) || rate == 0 || data == nullptr)
+			return false;
+
+		unsigned int sourceFrames = dataSize / (channels * bits / 8);
+		unsigned long long outputFrames = (unsigned long long)sourceFrames * WAV_OUTPUT_RATE / rate;
+		frames.resize((size_t)outputFrames * WAV_OUTPUT_CHANNELS);
+
+		for (size_t i = 0; i < outputFrames; i++)
+		{
+			// Position in the source, in 1/65536ths of a frame
+			unsigned long long position = (unsigned long long)i * rate * 65536 / WAV_OUTPUT_RATE;
+			unsigned int first = (unsigned int)(position >> 16);
+			unsigned int next = first + 1 < sourceFrames ? first + 1 : first;
+			int weight = (int)(position & 0xFFFF);
+
+			for (unsigned int c = 0; c < WAV_OUTPUT_CHANNELS; c++)
+			{
+				unsigned int channel = c < channels ? c : 0; // Mono plays on both sides
+				int a = SourceSample(data, first, channel, channels, bits);
+				int b = SourceSample(data, next, channel, channels, bits);
+				frames[i * WAV_OUTPUT_CHANNELS + c] = (short)(a + (((b - a) * weight) >> 16));
+			}
+		}
+
+		return true;
+	}
+
+	WavAudioBackend::WavAudioBackend(const std::string& path)
+	{
+		m_path = path;
+		m_framesWritten = 0;
+	}
+
+	bool WavAudioBackend::Init()
+	{
+		m_file.open(m_path.c_str(), std::ios::binary);
+		if (!m_file)
+		{
+			Log::Write(("Err: Could not open " + m_path + " for audio output!\n").c_str(), ENGINE_LOG);
+			return false;
+		}
+
+		// Sizes are filled in by Shutdown
+		WavHeader header =
+		{
+			{ 'R', 'I', 'F', 'F' }, 0, { 'W', 'A', 'V', 'E' }, { 'f', 'm', 't', ' ' }, 16, 1, WAV_OUTPUT_CHANNELS, WAV_OUTPUT_RATE,
+			WAV_OUTPUT_RATE * WAV_OUTPUT_CHANNELS * 2, WAV_OUTPUT_CHANNELS * 2, 16, { 'd', 'a', 't', 'a' }, 0
+		};
+		m_file.write((const char*)&header, sizeof(header));
+
+		m_start = std::chrono::steady_clock::now();
+		m_framesWritten = 0;
+		return true;
+	}
+
+	void WavAudioBackend::Shutdown()
+	{
+		Update();
+
+		unsigned int dataSize = (unsigned int)(m_framesWritten * WAV_OUTPUT_CHANNELS * 2);
+		unsigned int riffSize = dataSize + sizeof(WavHeader) - 8;
+		m_file.seekp(4);
+		m_file.write((const char*)&riffSize, sizeof(riffSize));
+		m_file.seekp(sizeof(WavHeader) - 4);
+		m_file.write((const char*)&dataSize, sizeof(dataSize));
+		m_file.close();
+
+		m_sounds.clear();
+	}
+
+	void WavAudioBackend::Load(SoundID sound, const char* path, bool loop, unsigned int voices)
+	{
+		if (sound >= m_sounds.size())
+			m_sounds.resize(sound + 1);
+
+		WavSound& s = m_sounds[sound];
+		s.frames.clear();
+		s.loop = loop;
+		WavVoice idle = { false, 0, 0 };
+		s.voices.assign(voices > 0 ? voices : 1, idle);
+
+		AssetView view;
+		std::vector<unsigned char> file;
+		if (!AssetArchive::Find(path, view))
+		{
+			std::ifstream source(path, std::ios::binary);
+			file.assign(std::istreambuf_iterator<char>(source), std::istreambuf_iterator<char>());
+			view.data = file.empty() ? nullptr : &file[0];
+			view.size = file.size();
+		}
+
+		if (view.data == nullptr || !DecodeWav(view.data, view.size, s.frames))
+			Log::Write(("Sound " + std::string(path) + " not loaded correctly!\n").c_str(), ENGINE_LOG);
+	}
+
+	void WavAudioBackend::LoadSample(SoundID sound, const char* path, unsigned int voices)
+	{
+		Load(sound, path, false, voices);
+	}
+
+	void WavAudioBackend::LoadMusic(SoundID sound, const char* path)
+	{
+		Load(sound, path, true, 1);
+	}
+
+	void WavAudioBackend::Play(SoundID sound)
+	{
+		if (sound >= m_sounds.size() || m_sounds[sound].frames.empty())
+			return;
+
+		// Everything up to now is written first, so the sound starts at the moment it was played
+		Update();
+
+		// A free voice, otherwise the one started longest ago
+		WavSound& s = m_sounds[sound];
+		WavVoice* voice = &s.voices[0];
+		for (size_t i = 0; i < s.voices.size(); i++)
+		{
+			if (!s.voices[i].playing)
+			{
+				voice = &s.voices[i];
+				break;
+			}
+			if (s.voices[i].started < voice->started)
+				voice = &s.voices[i];
+		}
+
+		voice->playing = true;
+		voice->position = 0;
+		voice->started = m_framesWritten;
+	}
+
+	void WavAudioBackend::Stop(SoundID sound)
+	{
+		if (sound >= m_sounds.size())
+			return;
+
+		Update();
+		for (size_t i = 0; i < m_sounds[sound].voices.size(); i++)
+			m_sounds[sound].voices[i].playing = false;
+	}
+
+	void WavAudioBackend::Update()
+	{
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+		MixTo((unsigned long long)(elapsed.count() * WAV_OUTPUT_RATE));
+	}
+
+	void WavAudioBackend::MixTo(unsigned long long frame)
+	{
+		if (frame <= m_framesWritten)
+			return;
+
+		size_t count = (size_t)(frame - m_framesWritten);
+		m_mix.assign(count * WAV_OUTPUT_CHANNELS, 0);
+
+		for (size_t i = 0; i < m_sounds.size(); i++)
+		{
+			WavSound& s = m_sounds[i];
+			size_t length = s.frames.size() / WAV_OUTPUT_CHANNELS;
+			for (size_t v = 0; v < s.voices.size(); v++)
+			{
+				WavVoice& voice = s.voices[v];
+				for (size_t f = 0; f < count && voice.playing; f++)
+				{
+					for (unsigned int c = 0; c < WAV_OUTPUT_CHANNELS; c++)
+						m_mix[f * WAV_OUTPUT_CHANNELS + c] += s.frames[voice.position * WAV_OUTPUT_CHANNELS + c];
+
+					if (++voice.position == length)
+					{
+						voice.position = 0;
+						voice.playing = s.loop;
+					}
+				}
+			}
+		}
+
+		m_output.resize(m_mix.size());
+		for (size_t i = 0; i < m_mix.size(); i++)
+			m_output[i] = (short)(m_mix[i] > 32767 ? 32767 : m_mix[i] < -32768 ? -32768 : m_mix[i]);
+
+		m_file.write((const char*)&m_output[0], m_output.size() * sizeof(short));
+		m_framesWritten = frame;
+	}
+}
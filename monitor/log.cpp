@@ -6,6 +6,7 @@
 | Author: Henri Keeble														|
 \-------------------------------------------------------------------------*/
 #include "log.h"
+#include <mutex>
 
 char* Log::m_workingDir = NULL;
 
@@ -34,25 +35,29 @@ char* Log::GetWorkingDir()
 	return m_workingDir;
 }
 
+// Executable directory, found on the first call
+static char currentDir[MAX_PATH];
+static std::once_flag currentDirFound;
+
 char* GetCurrentDir()
 {
-	// Get Path
-	TCHAR path[MAX_PATH];
-	GetModuleFileName(NULL, path, MAX_PATH);
-	
-	// Convert to string
-	std::stringstream ss;
-	ss << path;
-	std::string s = ss.str();
-
-	// Remove Executable Name
-	unsigned int pos = s.find_last_of("\\");
-	s = s.substr(0, pos+1);
-
-	char* realPath = (char*)calloc(strlen(s.c_str()), sizeof(char));
-	strcpy(realPath, s.c_str());
-
-	return realPath;
+	std::call_once(currentDirFound, []()
+	{
+		// Get Path
+		char path[MAX_PATH];
+		DWORD length = GetModuleFileNameA(NULL, path, MAX_PATH);
+		if (length == 0 || length >= MAX_PATH)
+			return;
+
+		// Remove Executable Name
+		char* name = strrchr(path, '\\');
+		if (name != NULL)
+			name[1] = '\0';
+
+		strcpy_s(currentDir, path);
+	});
+
+	return currentDir;
 }
 
 void Log::Shutdown()
@@ -163,6 +163,8 @@ private:
 	SpinnerType m_spinnerType;
 public:
 	Spinner(const Transform& pose, PxMaterial* material, const Vec3& color, const Fl32& density, const SpinnerType& type);
+	/* Wraps a spinner actor and joint that were already built */
+	Spinner(PxRigidActor* actor, PxRevoluteJoint* joint, const Vec3& color, const SpinnerType& type);
 	Spinner(const Spinner& param);
 	Spinner& operator=(const Spinner& param);
 	~Spinner();
@@ -170,6 +172,8 @@ public:
 	void SetKinematic(bool isKinematic);
 	void Toggle();
 
+	PxRevoluteJoint* GetJoint() const;
+
 	virtual void Create() override;
 };
 
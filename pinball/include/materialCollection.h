@@ -14,6 +14,6 @@ struct MaterialCollection
 	~MaterialCollection();
 
 	Vec3 wallColor, ballColor, boardColor, plungerColor, spinnerColor, flipperColor, wedgeColor, highBumperColor, lowBumperColor;
-	PxMaterial *wallMaterial, *ballMaterial, *boardMaterial, *plungerMaterial, *spinnerMaterial, *flipperMaterial, *wedgeMaterial, *bumperMaterial;
-	Fl32 wallDensity, ballDensity, boardDensity, plungerDensity, spinnerDensity, flipperDensity, wedgeDensity, bumperDensity;
+	PxMaterial *wallMaterial, *ballMaterial, *boardMaterial, *plungerMaterial, *spinnerMaterial, *flipperMaterial, *wedgeMaterial, *bumperMaterial, *switchMaterial;
+	Fl32 wallDensity, ballDensity, boardDensity, plungerDensity, spinnerDensity, flipperDensity, wedgeDensity, bumperDensity, switchDensity;
 };
\ No newline at end of file
@@ -19,7 +19,10 @@
 #include "timer.h"
 #include "monitor.h"
 #include "image.h"
+#include "stateImages.h"
 #include "materialCollection.h"
+#include "tableLayout.h"
+#include "CollectionCache.h"
 #include "sample.h"
 #include "backgroundmusic.h"
 
@@ -27,11 +30,13 @@
 using namespace GameFramework;
 using namespace Physics;
 
-// Simulation callback for scoring
+// Simulation callback for scoring. Bumper hits sound straight from here, as fetchResults reports them, rather than a frame later.
 class ScoreCallback : public Physics::SimulationEventCallback
 {
+private:
+	Sample* m_bumperSound;
 public:
-	ScoreCallback();
+	ScoreCallback(Sample* bumperSound);
 	virtual ~ScoreCallback();
 
 	virtual void onTrigger(PxTriggerPair* pairs, PxU32 count);
@@ -51,6 +56,12 @@ class Pinball : public GLUTGame
 		const int m_scorePerLowBumper = 50;
 		const int m_bumperBounceMultiplier = 100;
 
+		/* Bumper hits that can sound at once, enough for several balls working the bumpers together */
+		const unsigned int m_bumperVoices = 8;
+
+		/* Size of a bumper's inner bounce pyramid, relative to its trigger */
+		const Fl32 m_bumperBounceScale = .8f;
+
 		/* Collection of materials, for central editting file */
 		const MaterialCollection m_materials = MaterialCollection();
 
@@ -60,9 +71,13 @@ class Pinball : public GLUTGame
 
 		/* Actors */
 		std::vector<Actor*> m_actors;
+
+		/* Table layout, placing the wedges, bumpers, spinners and switches */
+		std::string m_tableName;
+		TableLayout m_table;
 		
-		/* Menu Images */
-		Image titleImg, gameOverImg, aboutImg, instructionImg, instruction2Img, backgroundImg;
+		/* Menu and background images, bound to the states that show them */
+		StateImages m_screens;
 
 		/* Actor Pointers (only kept for actors that need to be accessed after initialization) */
 		Sphere*		m_ball;
@@ -103,12 +118,20 @@ class Pinball : public GLUTGame
 		void InitPlunger();
 		void InitBall();
 		void InitJoints();
-		void InitCornerWedges();
 		void InitStartingBlocks();
-		void InitHighBumpers();
-		void InitLowBumpers();
-		void InitSpinners();
-		void InitSpinnerSwitches();
+
+		/* Builds the actors placed by the table layout, returns false if no table could be loaded */
+		bool InitTable();
+
+		/* Resolves a table element's anchored position against the board */
+		Transform TablePose(const TableElement& element);
+
+		/* Key of the table cache - a hash of the layout, and the board and material values its actors are built from */
+		unsigned long long TableKey() const;
+
+		/* Finds each table actor and joint in a cached collection, in the order the elements build them (their IDs are
+		   index + 1). Returns false if any is missing or of the wrong type. */
+		bool FindTableObjects(PxCollection& collection, std::vector<PxBase*>& objects) const;
 
 		/* Sound Initilization */
 		void InitSound();
@@ -137,6 +160,12 @@ class Pinball : public GLUTGame
 		/* Represents the game's HUD */
 		HUD hud;
 
+		/* Draws the HUD, from the copies of hud published in each snapshot */
+		HUD m_hudView;
+
+		/* Handles to the HUD items updated during play */
+		HUDHandle m_scoreItem, m_ballsLeftItem, m_fpsItem;
+
 		/* Used to Time the plunger */
 		Timer m_plungerTimer;
 
@@ -159,6 +188,16 @@ class Pinball : public GLUTGame
 		int m_scoreForThisBall;
 		Timer m_durationThisBallInPlay;
 
+		/* Steps physics while a game is in progress */
+		virtual void Simulate() override;
+
+		/* Captures the game state, visible shapes and HUD for Render */
+		virtual void CaptureSnapshot(FrameSnapshot& snapshot) override;
+
+		/* Render benchmark scenes (menu, in game, paused, game over) */
+		virtual int BenchmarkSceneCount() override;
+		virtual std::string SetBenchmarkScene(int scene) override;
+
 		/* Sounds */
 		Sample bumperSound, enterSound, loseSound, switchSound;
 		BackgroundMusic bgMusic;
@@ -171,12 +210,18 @@ class Pinball : public GLUTGame
 		/* Board Actor */
 		static Board* board;
 
+		/* Selects the table layout InitGame loads (from TABLE_DIR), DEFAULT_TABLE if not set */
+		void SetTable(const std::string& name);
+
+		/* Texture memory menu and background images may keep loaded, beyond those on screen (STATE_IMAGE_BUDGET if not set) */
+		void SetImageBudget(unsigned int bytes);
+
 		/* Activates spinners if they are inactive */
 		void ActivateSpinners();
 
 		/* Used by triggers to update the game */
-		static bool AddScoreHigh;
-		static bool AddScoreLow;
+		static int HighBumperHits;
+		static int LowBumperHits;
 		static bool BounceBall;
 		static bool EnableSpinners;
 		static Vec3 BallBounceDirection;
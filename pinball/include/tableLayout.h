@@ -0,0 +1,96 @@
+/*-------------------------------------------------------------------------\
+| File: TABLELAYOUT.H														|
+| Desc: Provides declarations for a pinball table layout, compiled from	|
+|		an editable text file into a flat binary loaded with one read.		|
+| Definition File: TABLELAYOUT.CPP											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#ifndef _TABLE_LAYOUT_H_
+#define _TABLE_LAYOUT_H_
+
+#include <string>
+#include <vector>
+
+// Directory holding table layouts, alongside img. Each table is a text source (name.table) and its compiled form (name.tbc).
+#define TABLE_DIR "tbl"
+#define TABLE_SOURCE_EXT ".table"
+#define TABLE_BINARY_EXT ".tbc"
+
+// A table's built PhysX objects, saved beside it as a binary collection
+#define TABLE_CACHE_EXT ".pxc"
+
+// Part of the table cache's key - raise it when the code building table actors changes, so old caches are rebuilt
+#define TABLE_CACHE_VERSION 1
+
+// Table loaded when none is given on the command line
+#define DEFAULT_TABLE "default"
+
+/* The kinds of element a layout can place */
+enum class TableElementKind : unsigned short
+{
+	Wedge,	 // Static wedge
+	Bumper,	 // Trigger pyramid, with a smaller static pyramid inside it for the ball to bounce off
+	Spinner, // Driven spinner
+	Switch	 // Trigger box that starts the spinners
+};
+
+/* Variants, stored in TableElement::variant */
+enum class BumperVariant : unsigned short { High, Low };
+enum class SpinnerVariant : unsigned short { Clockwise, Anticlockwise };
+
+/* Board edge an element's x or z offset is measured from */
+enum class TableAnchor : unsigned char
+{
+	Center,
+	Left,
+	Right,
+	Top,
+	Bottom
+};
+
+/* A single placed element, as stored in the binary. The position is resolved against the board when the actor is built:
+   x and z are offsets from their anchors, and the element sits lift above the board's surface at z. */
+struct TableElement
+{
+	unsigned short kind;
+	unsigned short variant;
+	unsigned char xAnchor, zAnchor;
+	unsigned short reserved;
+	float x, z, lift;
+	float scale[3];
+	float rotation[4]; // Quaternion (x, y, z, w)
+};
+
+class TableLayout
+{
+private:
+	/* The whole binary, elements follow the header in place */
+	std::vector<char> m_data;
+	const TableElement* m_elements;
+	unsigned int m_count;
+public:
+	TableLayout();
+	~TableLayout();
+
+	/* Loads a table by name, compiling its source first if the binary is missing or older than it. Returns false,
+	   leaving the layout empty, if neither can be read. */
+	bool Load(const std::string& name);
+
+	unsigned int Count() const;
+	const TableElement* Elements() const;
+
+	/* Number of elements of a kind */
+	unsigned int Count(TableElementKind kind) const;
+
+	/* Parses a text layout and writes its binary. Errors are logged with their line number. */
+	static bool Compile(const std::string& sourcePath, const std::string& binaryPath);
+
+	/* Path of a table's source or binary */
+	static std::string SourcePath(const std::string& name);
+	static std::string BinaryPath(const std::string& name);
+
+	/* Path of the cache of a table's built PhysX objects */
+	static std::string CachePath(const std::string& name);
+};
+
+#endif // _TABLE_LAYOUT_H_
@@ -271,6 +271,11 @@ Spinner::Spinner(const Transform& pose, PxMaterial* material, const Vec3& color,
 	m_geometrys[S_RIGHT].box() = geos[S_RIGHT];
 }
 
+Spinner::Spinner(PxRigidActor* actor, PxRevoluteJoint* joint, const Vec3& color, const SpinnerType& type) : CompoundShapeActor(actor, color), m_joint(joint)
+{
+	m_spinnerType = type;
+}
+
 Spinner::Spinner(const Spinner& param) : CompoundShapeActor(param)
 {
 	m_joint = param.m_joint;
@@ -319,6 +324,11 @@ void Spinner::Create()
 	SetKinematic(true);
 }
 
+PxRevoluteJoint* Spinner::GetJoint() const
+{
+	return m_joint.Get();
+}
+
 void Spinner::SetKinematic(bool isKinematic)
 {
 	m_actor.dynamicActor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, isKinematic);
@@ -8,13 +8,130 @@
 const int WIN_WIDTH = 700;
 const int WIN_HEIGHT = 700;
 
+// Render benchmark, run as: Pinball.exe -renderbench [frames] [-glcore] [-capture | -captureraw]
+const char* RENDER_BENCH_ARG = "-renderbench";
+const int RENDER_BENCH_FRAMES = 500;
+
+// Runs game logic and physics on a separate thread from rendering
+const char* THREADED_ARG = "-threaded";
+
+// Draws the board with the GL 3.3 core profile renderer
+const char* GL_CORE_ARG = "-glcore";
+
+// Records every frame, as a PNG sequence or a raw BGRA stream
+const char* CAPTURE_ARG = "-capture";
+const char* CAPTURE_RAW_ARG = "-captureraw";
+
+// Table layout to play, run as: Pinball.exe -table name (loads tbl\name.table)
+const char* TABLE_ARG = "-table";
+
+// Texture memory menu images may keep loaded, run as: Pinball.exe -imagebudget kilobytes
+const char* IMAGE_BUDGET_ARG = "-imagebudget";
+
+// Backend the game's sounds play through, run as: Pinball.exe -audio bass|null|wav (wav mixes them into audioOut.wav)
+const char* AUDIO_ARG = "-audio";
+
+// Audio buffering in milliseconds: the audio thread's period, the device buffer and BASS's update period
+const char* AUDIO_PERIOD_ARG = "-audioperiod";
+const char* AUDIO_BUFFER_ARG = "-audiobuffer";
+const char* AUDIO_UPDATE_ARG = "-audioupdate";
+
+// Trigger to output latency benchmark, run as: Pinball.exe -audiolatency [clicks] (with any of the buffering arguments)
+const char* AUDIO_LATENCY_ARG = "-audiolatency";
+const int AUDIO_LATENCY_CLICKS = 100;
+
+// Time to first frame benchmark, run as: Pinball.exe -startupbench [runs]. Each run relaunches the game with -startupprobe.
+const char* STARTUP_BENCH_ARG = "-startupbench";
+const char* STARTUP_PROBE_ARG = "-startupprobe";
+const int STARTUP_BENCH_RUNS = 5;
+
+// Packs img, sfx and msc into the asset archive beside the executable, then exits. Run after every build.
+const char* PACK_ASSETS_ARG = "-packassets";
+
+// True if any argument after the executable matches arg
+static bool HasArg(int argc, char *argv[], const char* arg)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], arg) == 0)
+			return true;
+	}
+	return false;
+}
+
+// The argument following arg, or NULL if arg isn't given (or is last)
+static const char* ArgValue(int argc, char *argv[], const char* arg)
+{
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], arg) == 0)
+			return argv[i + 1];
+	}
+	return NULL;
+}
+
 int main(int argc, char *argv[])
 {
 	InitLog(ENGINE_LOG);
 
+	if (argc > 1 && strcmp(argv[1], PACK_ASSETS_ARG) == 0)
+		return AssetArchive::Pack(GetCurrentDir(), std::string(GetCurrentDir()) + ASSET_ARCHIVE) ? 0 : 1;
+
+	AudioConfig audioConfig;
+	if (ArgValue(argc, argv, AUDIO_PERIOD_ARG))
+		audioConfig.threadPeriodMs = atoi(ArgValue(argc, argv, AUDIO_PERIOD_ARG));
+	if (ArgValue(argc, argv, AUDIO_BUFFER_ARG))
+		audioConfig.deviceBufferMs = atoi(ArgValue(argc, argv, AUDIO_BUFFER_ARG));
+	if (ArgValue(argc, argv, AUDIO_UPDATE_ARG))
+		audioConfig.updatePeriodMs = atoi(ArgValue(argc, argv, AUDIO_UPDATE_ARG));
+
+	if (argc > 1 && strcmp(argv[1], AUDIO_LATENCY_ARG) == 0)
+		return AudioLatencyBenchmark::Run(argc > 2 && atoi(argv[2]) > 0 ? atoi(argv[2]) : AUDIO_LATENCY_CLICKS, audioConfig);
+
+	// The benchmark only launches probes, so it does not need a game of its own
+	if (argc > 1 && strcmp(argv[1], STARTUP_BENCH_ARG) == 0)
+	{
+		std::string probeArgs = STARTUP_PROBE_ARG;
+		if (HasArg(argc, argv, GL_CORE_ARG))
+			probeArgs += std::string(" ") + GL_CORE_ARG;
+		if (ArgValue(argc, argv, TABLE_ARG))
+			probeArgs += std::string(" ") + TABLE_ARG + " " + ArgValue(argc, argv, TABLE_ARG);
+		return StartupBenchmark::Run(probeArgs, argc > 2 && atoi(argv[2]) > 0 ? atoi(argv[2]) : STARTUP_BENCH_RUNS);
+	}
+
 	Pinball game("Henri Keeble - KEE09195812 - CMP3001M - Assessment Item 1 - Pinball", WIN_WIDTH, WIN_HEIGHT);
 
-	game.Run(argc, argv);
+	if (HasArg(argc, argv, GL_CORE_ARG))
+		game.SetRenderBackend(RenderBackend::Core);
+	if (HasArg(argc, argv, CAPTURE_ARG))
+		game.SetCapture(true, CaptureFormat::PNG);
+	if (HasArg(argc, argv, CAPTURE_RAW_ARG))
+		game.SetCapture(true, CaptureFormat::Raw);
+	if (ArgValue(argc, argv, TABLE_ARG))
+		game.SetTable(ArgValue(argc, argv, TABLE_ARG));
+	if (ArgValue(argc, argv, IMAGE_BUDGET_ARG))
+		game.SetImageBudget(atoi(ArgValue(argc, argv, IMAGE_BUDGET_ARG)) * 1024);
+	game.SetAudioConfig(audioConfig);
+	if (ArgValue(argc, argv, AUDIO_ARG))
+	{
+		std::string backend = ArgValue(argc, argv, AUDIO_ARG);
+		if (backend == "null")
+			game.SetAudioBackend(AudioBackendType::Null);
+		else if (backend == "wav")
+			game.SetAudioBackend(AudioBackendType::WavWriter);
+		else
+			game.SetAudioBackend(AudioBackendType::BASS);
+	}
+
+	if (argc > 1 && strcmp(argv[1], STARTUP_PROBE_ARG) == 0)
+		game.RunStartupProbe(argc, argv);
+	else if (argc > 1 && strcmp(argv[1], RENDER_BENCH_ARG) == 0)
+		game.RunRenderBenchmark(argc, argv, argc > 2 && atoi(argv[2]) > 0 ? atoi(argv[2]) : RENDER_BENCH_FRAMES);
+	else
+	{
+		game.SetThreadedSimulation(HasArg(argc, argv, THREADED_ARG));
+		game.Run(argc, argv);
+	}
 
 	return 0;
 }
\ No newline at end of file
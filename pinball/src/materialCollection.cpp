@@ -29,6 +29,7 @@ MaterialCollection::MaterialCollection()
 	flipperDensity	= .5f;
 	wedgeDensity	= 1.f;
 	bumperDensity	= 1.f;
+	switchDensity	= 1.f;
 
 	// Materials
 	PxMaterial* steel	   = PHYSICS->createMaterial(0.0005f, 0.0004f, 0.397f);
@@ -44,6 +45,7 @@ MaterialCollection::MaterialCollection()
 	flipperMaterial = steel;
 	wedgeMaterial	= steel;
 	bumperMaterial  = hardRubber;
+	switchMaterial	= PHYSICS->createMaterial(0.f, 0.f, 2.f);
 }
 
 MaterialCollection::~MaterialCollection()
@@ -55,4 +57,5 @@ MaterialCollection::~MaterialCollection()
 	PX_RELEASE(spinnerMaterial);
 	PX_RELEASE(flipperMaterial);
 	PX_RELEASE(wedgeMaterial);
+	PX_RELEASE(switchMaterial);
 }
\ No newline at end of file
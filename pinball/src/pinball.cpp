@@ -13,8 +13,8 @@ const int MAX_NUM_ACTOR_SHAPES = 128;
 
 Board* Pinball::board;
 
-bool Pinball::AddScoreHigh = false;
-bool Pinball::AddScoreLow = false;
+int Pinball::HighBumperHits = 0;
+int Pinball::LowBumperHits = 0;
 bool Pinball::BounceBall = false;
 bool Pinball::EnableSpinners = false;
 Vec3 Pinball::BallBounceDirection = Vec3(0);
@@ -26,6 +26,7 @@ Pinball::Pinball(std::string title, int windowWidth, int windowHeight)
 	m_plunger = nullptr;
 	m_flippers = nullptr;
 	m_actors = std::vector<Actor*>();
+	m_tableName = DEFAULT_TABLE;
 	m_monitor = Monitor();
 	m_currentScore = 0;
 	m_scoreForThisBall = 0;
@@ -40,11 +41,17 @@ void Pinball::AddActors()
 {
 	Log::Write("Adding Actors to scene...\n", ENGINE_LOG);
 
-	for (std::vector<Actor*>::iterator iter = m_actors.begin(); iter != m_actors.end(); iter++)
-	{
-		Actor* act = *iter;
-		m_scene->Add(act);
-	}
+	m_scene->Add(m_actors);
+}
+
+void Pinball::SetTable(const std::string& name)
+{
+	m_tableName = name;
+}
+
+void Pinball::SetImageBudget(unsigned int bytes)
+{
+	m_screens.SetBudget(bytes);
 }
 
 void Pinball::TogglePause()
@@ -70,97 +77,112 @@ Transform Pinball::CreatePosition(const Fl32& x, const Fl32& z)
 	return Transform(Vec3(x, calcYOffset(z), z));
 }
 
-void Pinball::Render()
+void Pinball::CaptureSnapshot(FrameSnapshot& snapshot)
 {
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	GLUTGame::CaptureSnapshot(snapshot);
 
-	if (gameState == GameState::InGame || gameState == GameState::Paused)
-	{
-		Init2DCamera();
-		backgroundImg.Render();
-		Init3DCamera();
+	snapshot.state = gameState;
+	hud.Capture(snapshot.hud);
 
-		// Update Camera
-		camera.Update();
+	if (gameState != GameState::InGame && gameState != GameState::Paused)
+		return;
 
-		// Render Scene
-		std::vector<physx::PxRigidActor*> actors = m_scene->GetActors(physx::PxActorTypeSelectionFlag::eRIGID_DYNAMIC | physx::PxActorTypeSelectionFlag::eRIGID_STATIC); // get scene actors
-			
-		int nbActors = actors.size();
-		PxShape* shapes[MAX_NUM_ACTOR_SHAPES]; // Pointer to current actor shapes
+	UpdateFrustum();
+
+	std::vector<physx::PxRigidActor*> actors = m_scene->GetActors(physx::PxActorTypeSelectionFlag::eRIGID_DYNAMIC | physx::PxActorTypeSelectionFlag::eRIGID_STATIC); // get scene actors
+
+	int nbActors = actors.size();
+	PxShape* shapes[MAX_NUM_ACTOR_SHAPES]; // Pointer to current actor shapes
 
-		if (actors.size())
+	for (int i = 0; i < nbActors; i++)
+	{
+		if (i != GLASS_ATR_IDX && IsVisible(actors[i])) // Don't Render the glass, or actors out of view
 		{
-			for (int i = 0; i < nbActors; i++)
+			PxU32 nbShapes = actors[i]->getNbShapes();
+			if (nbShapes <= MAX_NUM_ACTOR_SHAPES)
 			{
-				if (i != GLASS_ATR_IDX) // Don't Render the glass
-				{
-					PxU32 nbShapes = actors[i]->getNbShapes();
-					if (nbShapes <= MAX_NUM_ACTOR_SHAPES)
-					{
-						actors[i]->getShapes(shapes, nbShapes);
+				actors[i]->getShapes(shapes, nbShapes);
 
-						bool isSleeping = actors[i]->isRigidDynamic() && actors[i]->isRigidDynamic()->isSleeping(); // Check if actor is sleeping
+				Vec3 aColor = *((Vec3*)actors[i]->userData);
 
-						for (int j = 0; j < nbShapes; j++)
-						{
-							Transform p = PxShapeExt::getGlobalPose(*shapes[j], *actors[i]);
-							PxGeometryHolder h = shapes[j]->getGeometry();
+				for (PxU32 j = 0; j < nbShapes; j++)
+				{
+					ShapeDraw draw;
+					SetShapePose(draw, actors[i], shapes[j]->getLocalPose()); // Interpolated between physics steps by the renderer, if enabled
+					draw.geometry = shapes[j]->getGeometry();
+					draw.color = aColor;
+					draw.textured = (i == 0); // Board is textured
+					snapshot.shapes.push_back(draw);
+				}
+			}
+			else
+				Log::Write("Exc: Too many shapes in actor!\n", ENGINE_LOG);
+		}
+	}
+}
 
-							Mat44 pose(p); // Create Matrix from vector
+void Pinball::Simulate()
+{
+	if (gameState == GameState::InGame || gameState == GameState::Paused)
+		StepPhysics();
+	else
+		SkipPhysics(); // Time spent in menus would otherwise start the next game with a burst of steps
+}
 
-							glPushMatrix();
-							glMultMatrixf((Fl32*)&pose); // Multiply current matrix by pose
+void Pinball::Render()
+{
+	// Draws only from the snapshot, as the simulation may be running on another thread
+	const FrameSnapshot& frame = Snapshot();
+	GameState state = (GameState)frame.state;
 
-							Vec3 aColor = *((Vec3*)actors[i]->userData);
-							glColor3f(aColor.x, aColor.y, aColor.z);
+	ClearFrame();
+	m_hudView.Apply(frame.hud);
 
-							if (h.getType() == PxGeometryType::ePLANE)
-								glDisable(GL_LIGHTING);
+	// Loads the state's images if they were evicted, and prefetches those it is likely to lead to
+	m_screens.Show(state);
 
-							if (i == 0) // Board is textured
-								GLUTGame::RenderGeometry(h, true);
-							else
-								GLUTGame::RenderGeometry(h);
+	if (state == GameState::InGame || state == GameState::Paused)
+	{
+		{
+			ProfileScope sceneScope(m_profiler, ProfilePhase::Scene);
 
-							if (h.getType() == PxGeometryType::ePLANE)
-								glEnable(GL_LIGHTING);
+			Init2DCamera();
+			m_screens.Render(state);
+			Init3DCamera();
 
-							glPopMatrix();
+			// Update Camera
+			camera.Update();
 
-							Vec3 defCol = DEFAULT_COLOR;
-							glColor3f(defCol.x, defCol.y, defCol.z);
-						}
-					}
-					else
-						Log::Write("Exc: Too many shapes in actor!\n", ENGINE_LOG);
-				}
-			}
+			// Render Scene
+			RenderShapes(frame);
 		}
 
-		/* Update Physics */
-		m_scene->UpdatePhys(1 / FPS);
-
 		CalculateFrameRate();
-		hud.UpdateItem("FPS", m_fps);
 	}
-	if (gameState == GameState::Menu)
-		titleImg.Render();
-	else if (gameState == GameState::Instructions)
-		instructionImg.Render();
-	else if (gameState == GameState::Instructions2)
-		instruction2Img.Render();
-	else if (gameState == GameState::About)
-		aboutImg.Render();
-	else if (gameState == GameState::GameOver)
+	if (state == GameState::Menu)
 	{
-		gameOverImg.Render();
-		hud.Render(camera.FOV);
+		m_screens.Render(state);
+
+		// Startup ends with the first frame showing the title
+		if (m_screens.IsLoaded(state))
+			MarkStartupComplete();
+	}
+	else if (state == GameState::Instructions || state == GameState::Instructions2 || state == GameState::About)
+		m_screens.Render(state);
+	else if (state == GameState::GameOver)
+	{
+		m_screens.Render(state);
+
+		ProfileScope hudScope(m_profiler, ProfilePhase::HUD);
+		m_hudView.Render(camera.FOV);
 	}
 	else
-		hud.Render(camera.FOV);
+	{
+		ProfileScope hudScope(m_profiler, ProfilePhase::HUD);
+		m_hudView.Render(camera.FOV);
+	}
 
-	glutSwapBuffers();
+	PresentFrame();
 }
 
 void Pinball::Idle()
@@ -169,8 +191,8 @@ void Pinball::Idle()
 
 	if (gameState == GameState::InGame)
 	{
-		/* Update music */
-		bgMusic.Update();
+		/* Frame rate is measured by the renderer */
+		hud.UpdateItem(m_fpsItem, m_fps);
 
 		/* Check if plunger needs reset */
 		if (m_plunger->IsReady() == false)
@@ -196,7 +218,7 @@ void Pinball::Idle()
 				m_currentScore += m_scorePerSecond;
 				m_scoreForThisBall += m_scorePerSecond;
 				m_scoreTimer.Reset();
-				hud.UpdateItem("Score", m_currentScore);
+				hud.UpdateItem(m_scoreItem, m_currentScore);
 			}
 		}
 		else if (m_ball->Pose().p.x > 0.4)// Else, check if ball needs to be set to in play
@@ -217,7 +239,7 @@ void Pinball::Idle()
 			m_ball->Get().dynamicActor->setLinearVelocity(Vec3(0));
 			m_ball->Get().dynamicActor->setAngularVelocity(Vec3(0));
 			m_ball->Get().dynamicActor->setGlobalPose(m_ballInitialPos);
-			hud.UpdateItem("Balls Left", m_ballsRemaining);
+			hud.UpdateItem(m_ballsLeftItem, m_ballsRemaining);
 
 			if (m_ballsRemaining == 0)
 			{
@@ -228,21 +250,17 @@ void Pinball::Idle()
 			}
 		}
 
-		/* Check for bumper scoring */
-		if (AddScoreHigh)
+		/* Check for bumper scoring - every hit scores (ScoreCallback has already played its sound) */
+		for (; HighBumperHits > 0; HighBumperHits--)
 		{
-			bumperSound.Play();
 			m_currentScore += m_scorePerHighBumper;
 			m_scoreForThisBall += m_scorePerHighBumper;
-			AddScoreHigh = false;
 		}
 
-		if (AddScoreLow)
+		for (; LowBumperHits > 0; LowBumperHits--)
 		{
-			bumperSound.Play();
 			m_currentScore += m_scorePerLowBumper;
 			m_scoreForThisBall += m_scorePerLowBumper;
-			AddScoreLow = false;
 		}
 
 		/* Check for bounces */
@@ -280,6 +298,7 @@ void Pinball::Idle()
 void Pinball::Reshape(int width, int height)
 {
 	GLUTGame::Reshape(width, height);
+	m_hudView.Resize(width, height);
 }
 
 void Pinball::MouseButton(int button, int state, int x, int y)
@@ -305,20 +324,19 @@ void Pinball::KeyboardDown(unsigned char key, int x, int y)
 			gameState = GameState::InGame;
 			Reset();
 			InitHUD();
-			Init3DCamera();
-			glutPostRedisplay();
+			PostRedisplay();
 		}
 		if (key == 'i')
 		{
 			enterSound.Play();
 			gameState = GameState::Instructions;
-			glutPostRedisplay();
+			PostRedisplay();
 		}
 		if (key == 'a')
 		{
 			enterSound.Play();
 			gameState = GameState::About;
-			glutPostRedisplay();
+			PostRedisplay();
 		}
 		break;
 		/* InGame Keys */
@@ -355,7 +373,7 @@ void Pinball::KeyboardDown(unsigned char key, int x, int y)
 		if (key == VK_BACK)
 		{
 			gameState = GameState::Menu;
-			glutPostRedisplay();
+			PostRedisplay();
 		}
 	}
 
@@ -364,7 +382,7 @@ void Pinball::KeyboardDown(unsigned char key, int x, int y)
 		if (key == VK_RETURN)
 		{
 			gameState = GameState::Instructions2;
-			glutPostRedisplay();
+			PostRedisplay();
 		}
 	}
 
@@ -376,7 +394,7 @@ void Pinball::KeyboardDown(unsigned char key, int x, int y)
 
 	// Keys applicable to all states
 	if(key == VK_ESCAPE)
-		exit(0);
+		RequestExit();
 }
 
 void Pinball::KeyboardUp(unsigned char key, int x, int y)
@@ -399,7 +417,18 @@ void Pinball::KeyboardUp(unsigned char key, int x, int y)
 
 void Pinball::SpecKeyboardDown(int key, int x, int y)
 {
-
+	// Profiling keys, applicable to all states
+	if (key == GLUT_KEY_F2)
+		ToggleProfileGraph();
+	if (key == GLUT_KEY_F3)
+		ReportProfile();
+	if (key == GLUT_KEY_F4)
+	{
+		SetRenderInterpolation(!RenderInterpolation());
+		Log::Write(RenderInterpolation() ? "Render interpolation on\n" : "Render interpolation off\n", ENGINE_LOG);
+	}
+	if (key == GLUT_KEY_F5)
+		SetCapture(!IsCapturing());
 }
 
 void Pinball::SpecKeyboardUp(int key, int x, int y)
@@ -430,6 +459,36 @@ void Pinball::ActivateSpinners()
 	}
 }
 
+int Pinball::BenchmarkSceneCount()
+{
+	return 4;
+}
+
+std::string Pinball::SetBenchmarkScene(int scene)
+{
+	switch (scene)
+	{
+	case 0:
+		gameState = GameState::Menu;
+		InitHUD();
+		return "Menu";
+	case 1:
+		gameState = GameState::InGame;
+		Reset();
+		InitHUD();
+		return "InGame";
+	case 2:
+		TogglePause(); // Sets the Paused state and HUD
+		return "Paused";
+	default:
+		if (m_paused)
+			TogglePause();
+		gameState = GameState::GameOver;
+		InitHUD();
+		return "GameOver";
+	}
+}
+
 void Pinball::Exit()
 {
 	GLUTGame::Exit();
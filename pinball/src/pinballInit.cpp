@@ -18,25 +18,55 @@ void Pinball::Init()
 	// Set State
 	gameState = GameState::Menu;
 
-	// Initialize Camera
+	// Initialize Camera (the 3D camera never moves, so is only set here)
+	camera = { UP_VECTOR, Vec3(0, 0, 0), Vec3(0, 1, -5.5), DEFAULT_FOV };
 	Init2DCamera();
 
 	// Set Clear Color
 	SetClearColor(GetClearColor());
 
-	// Set Images
-	titleImg = Image("titleTexture.png");
-	gameOverImg = Image("gameOverTexture.png");
-	aboutImg = Image("about.png");
-	instructionImg = Image("instructions.png");
-	instruction2Img = Image("instructions2.png");
-	backgroundImg = Image("backgroundTexture.png");
+	// Build HUD glyph atlases (before the first frame, as this draws to the back buffer)
+	{
+		TraceScope scope("HUD");
+		m_hudView.Init(WindowDimensions().x, WindowDimensions().y);
+	}
+
+	// Set Images - each is loaded in the background when its state shows, or when a state likely to lead to it does
+	{
+		TraceScope scope("Images");
+		m_screens.Bind(GameState::Menu, "titleTexture.png");
+		m_screens.Bind(GameState::GameOver, "gameOverTexture.png");
+		m_screens.Bind(GameState::About, "about.png");
+		m_screens.Bind(GameState::Instructions, "instructions.png");
+		m_screens.Bind(GameState::Instructions2, "instructions2.png");
+		m_screens.Bind(GameState::InGame, "backgroundTexture.png");
+		m_screens.Bind(GameState::Paused, "backgroundTexture.png");
+
+		// Menu keys, and the ways back to it
+		m_screens.Link(GameState::Menu, GameState::InGame);
+		m_screens.Link(GameState::Menu, GameState::Instructions);
+		m_screens.Link(GameState::Menu, GameState::About);
+		m_screens.Link(GameState::Instructions, GameState::Instructions2);
+		m_screens.Link(GameState::Instructions2, GameState::Menu);
+		m_screens.Link(GameState::About, GameState::Menu);
+		m_screens.Link(GameState::InGame, GameState::GameOver);
+		m_screens.Link(GameState::GameOver, GameState::Menu);
+
+		// The title first, so the menu can show as soon as it is ready
+		m_screens.Show(GameState::Menu);
+	}
 
 	// Initialize Scene
-	InitGame();
+	{
+		TraceScope scope("InitGame");
+		InitGame();
+	}
 
 	// Initialize sounds
-	InitSound();
+	{
+		TraceScope scope("InitSound");
+		InitSound();
+	}
 }
 
 void Pinball::InitGame()
@@ -48,11 +78,12 @@ void Pinball::InitGame()
 	InitFlippers();
 	InitBall();
 	InitPlunger();
-	InitCornerWedges();
-	InitHighBumpers();
-	InitLowBumpers();
-	InitSpinners();
-	InitSpinnerSwitches();
+	if (!InitTable())
+	{
+		Log::Write("Err: No playable table layout, exiting!\n", ENGINE_LOG);
+		RequestExit(1);
+		return;
+	}
 
 	// Add Actors in game to scene
 	AddActors();
@@ -73,21 +104,22 @@ void Pinball::InitGame()
 	m_gameDuration = Timer();
 
 	// Set Simulation Callback
-	m_scene->SetEventCallback(new ScoreCallback());
+	m_scene->SetEventCallback(new ScoreCallback(&bumperSound));
 }
 
 void Pinball::InitHUD()
 {
 	hud.Clear();
+	m_scoreItem = m_ballsLeftItem = m_fpsItem = HUDHandle();
 
 	switch (gameState)
 	{
 	case GameState::InGame:
 		SetClearColor(Vec3(0.f, 0.f, 0.f));
 		hud.SetRenderColor(Vec3(1.f, 1.f, 1.f));
-		hud.AddItem("Score", Vec2(5, 95), HUDFont::largeFont, true, 0);
-		hud.AddItem("Balls Left", Vec2(65, 95), HUDFont::largeFont, true, m_ballsRemaining);
-		hud.AddItem("FPS", Vec2(5, 5), HUDFont::largeFont, true, m_fps);
+		m_scoreItem = hud.AddItem("Score", Vec2(5, 95), HUDFont::largeFont, true, 0);
+		m_ballsLeftItem = hud.AddItem("Balls Left", Vec2(65, 95), HUDFont::largeFont, true, m_ballsRemaining);
+		m_fpsItem = hud.AddItem("FPS", Vec2(5, 5), HUDFont::largeFont, true, m_fps);
 		break;
 	case GameState::GameOver:
 		SetClearColor(Vec3(0.f, 0.f, 0.f));
@@ -106,7 +138,6 @@ void Pinball::Init3DCamera()
 {
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
-	camera = { UP_VECTOR, Vec3(0, 0, 0), Vec3(0, 1, -5.5), DEFAULT_FOV };
 	camera.Update(); // Used to initialize camera positions (gluLookAt)
 	UpdatePerspective(camera.FOV);
 
@@ -208,229 +239,285 @@ void Pinball::InitPlunger()
 	m_actors.push_back(m_plunger);
 }
 
-void Pinball::InitCornerWedges()
+bool Pinball::InitTable()
 {
-	Log::Write("\tInitializing Corner Wedges...\n", ENGINE_LOG);
-
-	Fl32 zOffset, xOffset, yOffset;
-	Transform pose;
-	zOffset = xOffset = yOffset = 0.f;
-	pose = Transform::createIdentity();
-
-	Vec3 scale = Vec3(.3f, .3f, .05f);
-
-	// Top Right Wedge
-	zOffset = board->Top().z - board->WallWidth() - .35f;
-	xOffset = board->Right().x + board->WallWidth() + .25f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(180), Vec3(0, 1, 0)) * Quat(DEG2RAD(25), Vec3(1, 0, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-	
-	// Top Left Wedge
-	zOffset = board->Top().z - board->WallWidth() - .5f;
-	xOffset = board->Left().x - board->WallWidth() - .08f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-90), Vec3(0, 1, 0)) * Quat(DEG2RAD(25), Vec3(0, 0, 1)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-
-	// Bottom Left Wedge
-	zOffset = board->Bottom().z - board->WallWidth() + .3f;
-	xOffset = board->Left().x - board->WallWidth() - .35f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-25), Vec3(1, 0, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-
-	// Bottom Right Wedge
-	scale = Vec3(.2f, .4f, .05f);
-	zOffset = board->Bottom().z + board->WallWidth() + .35f;
-	xOffset = board->Right().x + board->WallWidth() + .35f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-25), Vec3(1, 0, 0)) * Quat(DEG2RAD(90), Vec3(0, 1, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-
-	// Exit Plunger Lane Wedge
-	scale = Vec3(.2f, .4f, .05f);
-	zOffset = board->Top().z - board->WallWidth() - 1.7f;
-	xOffset = board->Left().x - board->WallWidth() - .25f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-25), Vec3(1, 0, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-
-	// Flipper Right Wedge
-	scale = Vec3(.5f, .4f, .05f);
-	zOffset = board->Bottom().z + board->WallWidth() + .6f;
-	xOffset = board->Left().x - board->WallWidth() - .55f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-25), Vec3(1, 0, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
-
-	// Flipper Right Wedge
-	scale = Vec3(.2f, .8f, .05f);
-	zOffset = board->Bottom().z + board->WallWidth() + .76f;
-	xOffset = board->Right().x - board->WallWidth() + .49f;
-	yOffset = calcYOffset(zOffset);
-	pose = Transform(Vec3(xOffset, yOffset + (scale.z * 2), zOffset), Quat(DEG2RAD(-25), Vec3(1, 0, 0))  * Quat(DEG2RAD(90), Vec3(0, 1, 0)));
-	m_actors.push_back(ConvexMeshActor::CreateWedge(pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, Physics::ActorType::StaticActor));
+	Log::Write("\tInitializing Table Layout...\n", ENGINE_LOG);
+
+	std::string tableName = m_tableName;
+	if (!m_table.Load(tableName))
+	{
+		if (tableName == DEFAULT_TABLE || !m_table.Load(DEFAULT_TABLE))
+			return false;
+		tableName = DEFAULT_TABLE;
+	}
+
+	// The built table (actors, their shapes, cooked meshes and materials, and the spinners' joints) is read back from the
+	// table's cache when it was written for the same key. Otherwise it is built through the PhysX API, then cached.
+	std::string cachePath = TableLayout::CachePath(tableName);
+	unsigned long long key = TableKey();
+
+	// Each table actor and joint, in the order the elements build them
+	std::vector<PxBase*> objects;
+	bool cached = false;
+
+	PxCollection* collection = CollectionCache::Read(cachePath, key);
+	if (collection != nullptr)
+	{
+		cached = FindTableObjects(*collection, objects);
+		if (!cached)
+		{
+			CollectionCache::ReleaseObjects(*collection);
+			objects.clear();
+		}
+		collection->release(); // Leaves the objects
+	}
+
+	// Otherwise, gather the meshes the layout uses. Each is cooked once (all of them concurrently), and shared by every
+	// element using it at that element's scale.
+	PxConvexMesh* wedgeMesh = nullptr;
+	PxConvexMesh* pyramidMesh = nullptr;
+	if (!cached)
+	{
+		std::vector<PxConvexMeshDesc> meshDescs;
+		int wedgeIdx = -1, pyramidIdx = -1;
+		if (m_table.Count(TableElementKind::Wedge) > 0)
+		{
+			wedgeIdx = (int)meshDescs.size();
+			meshDescs.push_back(ConvexMeshActor::WedgeDesc());
+		}
+		if (m_table.Count(TableElementKind::Bumper) > 0)
+		{
+			pyramidIdx = (int)meshDescs.size();
+			meshDescs.push_back(ConvexMeshActor::PyramidDesc());
+		}
+
+		std::vector<PxConvexMesh*> meshes = CookAll(meshDescs);
+		for (size_t i = 0; i < meshes.size(); i++)
+		{
+			if (meshes[i] == nullptr)
+				return false;
+		}
+		wedgeMesh = wedgeIdx >= 0 ? meshes[wedgeIdx] : nullptr;
+		pyramidMesh = pyramidIdx >= 0 ? meshes[pyramidIdx] : nullptr;
+	}
+
+	// Spinners and switches, in the order the table lists them (loading guarantees two of each)
+	Spinner* spinners[2];
+	Box* switches[2];
+	int spinnerCount = 0, switchCount = 0;
+
+	// Next cached object to wrap
+	size_t next = 0;
+
+	const TableElement* elements = m_table.Elements();
+	m_actors.reserve(m_actors.size() + m_table.Count() + m_table.Count(TableElementKind::Bumper));
+
+	for (unsigned int i = 0; i < m_table.Count(); i++)
+	{
+		const TableElement& element = elements[i];
+		Transform pose = TablePose(element);
+		Vec3 scale = Vec3(element.scale[0], element.scale[1], element.scale[2]);
+
+		switch ((TableElementKind)element.kind)
+		{
+		case TableElementKind::Wedge:
+		{
+			ConvexMeshActor* wedge;
+			if (cached)
+				wedge = new ConvexMeshActor(objects[next++]->is<PxRigidActor>(), m_materials.wedgeColor);
+			else
+			{
+				wedge = new ConvexMeshActor(wedgeMesh, pose, m_materials.wedgeDensity, m_materials.wedgeColor, m_materials.wallMaterial, scale, ActorType::StaticActor);
+				objects.push_back(wedge->GetRigidActor());
+			}
+			m_actors.push_back(wedge);
+			break;
+		}
+		case TableElementKind::Bumper:
+		{
+			bool high = element.variant == (unsigned short)BumperVariant::High;
+			const Vec3& color = high ? m_materials.highBumperColor : m_materials.lowBumperColor;
+
+			ConvexMeshActor* bumper;
+			ConvexMeshActor* bounce; // Actor used for bounce...
+			if (cached)
+			{
+				bumper = new ConvexMeshActor(objects[next++]->is<PxRigidActor>(), color);
+				bounce = new ConvexMeshActor(objects[next++]->is<PxRigidActor>(), color);
+			}
+			else
+			{
+				bumper = new ConvexMeshActor(pyramidMesh, pose, m_materials.bumperDensity, color, m_materials.bumperMaterial, scale, ActorType::DynamicActor);
+				bumper->IsTrigger(true);
+				bounce = new ConvexMeshActor(pyramidMesh, pose, m_materials.bumperDensity, color, m_materials.bumperMaterial, scale * m_bumperBounceScale,
+					ActorType::StaticActor);
+				objects.push_back(bumper->GetRigidActor());
+				objects.push_back(bounce->GetRigidActor());
+			}
+
+			// Named either way, as the trigger callback compares names by pointer and a cached name is a copy
+			bumper->Get().dynamicActor->setName(high ? "BumperHigh" : "BumperLow");
+			m_actors.push_back(bumper);
+			m_actors.push_back(bounce);
+			break;
+		}
+		case TableElementKind::Spinner:
+		{
+			SpinnerType type = element.variant == (unsigned short)SpinnerVariant::Clockwise ? SpinnerType::CLOCKWISE : SpinnerType::ANTICLOCKWISE;
+			Spinner* spinner;
+			if (cached)
+			{
+				PxRigidActor* actor = objects[next++]->is<PxRigidActor>();
+				PxRevoluteJoint* joint = objects[next++]->is<PxRevoluteJoint>();
+				spinner = new Spinner(actor, joint, m_materials.spinnerColor, type);
+			}
+			else
+			{
+				spinner = new Spinner(pose, m_materials.spinnerMaterial, m_materials.spinnerColor, m_materials.spinnerDensity, type);
+				spinner->Create(); // Now rather than when added to the scene, so it can be cached
+				objects.push_back(spinner->GetRigidActor());
+				objects.push_back(spinner->GetJoint());
+			}
+			spinners[spinnerCount++] = spinner;
+			m_actors.push_back(spinner);
+			break;
+		}
+		case TableElementKind::Switch:
+		{
+			Box* spinnerSwitch;
+			if (cached)
+				spinnerSwitch = new Box(objects[next++]->is<PxRigidActor>(), m_switchOffColor);
+			else
+			{
+				spinnerSwitch = new Box(pose, scale, m_materials.switchDensity, m_switchOffColor, m_materials.switchMaterial);
+				spinnerSwitch->IsTrigger(true);
+				objects.push_back(spinnerSwitch->GetRigidActor());
+			}
+			spinnerSwitch->Get().dynamicActor->setName("SpinnerSwitch");
+			switches[switchCount++] = spinnerSwitch;
+			m_actors.push_back(spinnerSwitch);
+			break;
+		}
+		}
+	}
+
+	if (cached)
+		Log::Write(("\tRead " + std::to_string(objects.size()) + " table actors and joints from " + cachePath + "\n").c_str(), ENGINE_LOG);
+	else
+	{
+		PxCollection* written = PxCreateCollection();
+		for (size_t i = 0; i < objects.size(); i++)
+			written->add(*objects[i], i + 1);
+		CollectionCache::Write(cachePath, key, *written);
+		written->release();
+	}
+
+	// Create Spinners Object
+	m_spinners = new Spinners(spinners[0], spinners[1]);
+
+	// Retain pointers to access later, so color may be changed
+	m_spinnerSwitchLft = switches[0];
+	m_spinnerSwitchRgt = switches[1];
+
+	return true;
 }
 
-void Pinball::InitHighBumpers()
+// Accumulates the values a material is built from
+static void HashMaterial(unsigned long long& key, const PxMaterial* material)
 {
-	// Variables
-	ConvexMeshActor* currentActor; // The current actor
-	Fl32 zCenter, xCenter, zAbs, xAbs; // Center of bumpers, absolute position of current actor
-	Transform rotation = Transform(Quat(DEG2RAD(-115), Vec3(1, 0, 0)));
-
-	// Actor Parameters
-	Vec3 scale = Vec3(0.2f, 0.1f, 0.2f);
-	Vec3 scale2 = scale*0.8f;
-
-	zCenter = board->Center().z + 1.f;
-	xCenter = board->Center().x + 0.1f;
-
-	zAbs = zCenter;
-	xAbs = xCenter - .7f;
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale, ActorType::DynamicActor);
-	currentActor->IsTrigger(true);
-	currentActor->Get().dynamicActor->setName("BumperHigh");
-	m_actors.push_back(currentActor);
-
-	// Actor used for bounce...
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale2, ActorType::StaticActor);
-	m_actors.push_back(currentActor);
-
-	zAbs = zCenter;
-	xAbs = xCenter + .7f;
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale, ActorType::DynamicActor);
-	currentActor->IsTrigger(true);
-	currentActor->Get().dynamicActor->setName("BumperHigh");
-	m_actors.push_back(currentActor);
-
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale2, ActorType::StaticActor);
-	m_actors.push_back(currentActor);
-
-	zAbs = zCenter - .4f;
-	xAbs = xCenter;
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale, ActorType::DynamicActor);
-	currentActor->IsTrigger(true);
-	currentActor->Get().dynamicActor->setName("BumperHigh");
-	m_actors.push_back(currentActor);
-
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.highBumperColor, m_materials.bumperMaterial,
-		scale2, ActorType::StaticActor);
-	m_actors.push_back(currentActor);
+	Fl32 values[] = { material->getStaticFriction(), material->getDynamicFriction(), material->getRestitution() };
+	CollectionCache::Hash(key, values, sizeof(values));
 }
 
-void Pinball::InitLowBumpers()
+unsigned long long Pinball::TableKey() const
 {
-	// Variables
-	ConvexMeshActor* currentActor; // The current actor
-	Fl32 zCenter, xCenter, zAbs, xAbs; // Center of bumpers, absolute position of current actor
-	Transform rotation = Transform(Quat(DEG2RAD(-115), Vec3(1, 0, 0)));
-
-	// Actor Parameters
-	Vec3 scale = Vec3(0.15f, 0.1f, 0.15f);
-	Vec3 scale2 = scale*0.8f;
-
-	zCenter = board->Center().z - 1.1f;
-	xCenter = board->Center().x;
-
-	zAbs = zCenter;
-	xAbs = xCenter - .5f;
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.lowBumperColor, m_materials.bumperMaterial,
-		scale, ActorType::DynamicActor);
-	currentActor->IsTrigger(true);
-	currentActor->Get().dynamicActor->setName("BumperLow");
-	m_actors.push_back(currentActor);
-
-	// Actor used for bounce...
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.lowBumperColor, m_materials.bumperMaterial,
-		scale2, ActorType::StaticActor);
-	m_actors.push_back(currentActor);
-
-	zAbs = zCenter - .5f;
-	xAbs = xCenter + .6f;
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.lowBumperColor, m_materials.bumperMaterial,
-		scale, ActorType::DynamicActor);
-	currentActor->IsTrigger(true);
-	currentActor->Get().dynamicActor->setName("BumperLow");
-	m_actors.push_back(currentActor);
-
-	currentActor = ConvexMeshActor::CreatePyramid(CreatePosition(xAbs, zAbs) * Transform(Vec3(0, 0.1f, 0)) * rotation, m_materials.bumperDensity, m_materials.lowBumperColor, m_materials.bumperMaterial,
-		scale2, ActorType::StaticActor);
-	m_actors.push_back(currentActor);
+	unsigned long long key = COLLECTION_HASH_SEED;
+
+	unsigned int version = TABLE_CACHE_VERSION;
+	CollectionCache::Hash(key, &version, sizeof(version));
+	if (m_table.Count() > 0)
+		CollectionCache::Hash(key, m_table.Elements(), m_table.Count() * sizeof(TableElement));
+
+	// Elements are placed against the board, and spinners sized by it
+	Transform boardPose = board->Pose();
+	Vec3 boardDimensions = board->Dimensions();
+	Fl32 wallHeight = board->WallHeight();
+	CollectionCache::Hash(key, &boardPose, sizeof(boardPose));
+	CollectionCache::Hash(key, &boardDimensions, sizeof(boardDimensions));
+	CollectionCache::Hash(key, &wallHeight, sizeof(wallHeight));
+	CollectionCache::Hash(key, &m_bumperBounceScale, sizeof(m_bumperBounceScale));
+
+	// Densities set the actors' masses and materials are copied into each actor. Colours are left out, as they are
+	// applied to the wrappers rather than stored in the collection.
+	const Fl32 densities[] = { m_materials.wallDensity, m_materials.ballDensity, m_materials.boardDensity, m_materials.plungerDensity,
+		m_materials.spinnerDensity, m_materials.flipperDensity, m_materials.wedgeDensity, m_materials.bumperDensity, m_materials.switchDensity };
+	CollectionCache::Hash(key, densities, sizeof(densities));
+
+	const PxMaterial* materials[] = { m_materials.wallMaterial, m_materials.ballMaterial, m_materials.boardMaterial, m_materials.plungerMaterial,
+		m_materials.spinnerMaterial, m_materials.flipperMaterial, m_materials.wedgeMaterial, m_materials.bumperMaterial, m_materials.switchMaterial };
+	for (size_t i = 0; i < sizeof(materials) / sizeof(materials[0]); i++)
+		HashMaterial(key, materials[i]);
+
+	return key;
 }
 
-void Pinball::InitSpinnerSwitches()
+bool Pinball::FindTableObjects(PxCollection& collection, std::vector<PxBase*>& objects) const
 {
-	// Actor Parameters
-	PxMaterial* material = PHYSICS->createMaterial(0, 0, 2.f);
-	Vec3 dimensions = Vec3(.1f, 0.01f, .1f);
-	Fl32 density = 1.f;
-
-	Fl32 xOffset, zOffset;
-	Box* lft, *rgt;
-
-	// Trigger Object
-	zOffset = board->Center().z - 1.5f;
-	xOffset = board->Left().x - .195f;
-	lft = new Box(Transform(Vec3(xOffset, calcYOffset(zOffset) + 0.05f, zOffset)), dimensions, density, m_switchOffColor, material);
-	lft->IsTrigger(true);
-	lft->Get().dynamicActor->setName("SpinnerSwitch");
-	
-	// Trigger Object
-	zOffset = board->Center().z - 1.5f;
-	xOffset = board->Right().x + .5f;
-	rgt = new Box(Transform(Vec3(xOffset, calcYOffset(zOffset) + 0.05f, zOffset)), dimensions, density, m_switchOffColor, material);
-	rgt->IsTrigger(true);
-	rgt->Get().dynamicActor->setName("SpinnerSwitch");
-
-	// Rotate for board placement
-	lft->Get().dynamicActor->setGlobalPose(lft->Get().dynamicActor->getGlobalPose() * Transform(Quat(DEG2RAD(-25), Vec3(1, 0, 0))));
-	rgt->Get().dynamicActor->setGlobalPose(rgt->Get().dynamicActor->getGlobalPose() * Transform(Quat(DEG2RAD(-25), Vec3(1, 0, 0))));
-
-	// Retain pointers to access later, so color may be changed
-	m_spinnerSwitchLft = lft;
-	m_spinnerSwitchRgt = rgt;
+	PxSerialObjectId id = 1;
+	const TableElement* elements = m_table.Elements();
+	for (unsigned int i = 0; i < m_table.Count(); i++)
+	{
+		// The actors each element builds, and a joint for a spinner
+		TableElementKind kind = (TableElementKind)elements[i].kind;
+		int actors = kind == TableElementKind::Bumper ? 2 : 1;
+		bool joint = kind == TableElementKind::Spinner;
+
+		for (int a = 0; a < actors; a++)
+		{
+			PxBase* object = collection.find(id++);
+			if (object == nullptr || !object->is<PxRigidActor>())
+				return false;
+			objects.push_back(object);
+		}
+
+		if (joint)
+		{
+			PxBase* object = collection.find(id++);
+			if (object == nullptr || !object->is<PxRevoluteJoint>())
+				return false;
+			objects.push_back(object);
+		}
+	}
 
-	m_actors.push_back(lft);
-	m_actors.push_back(rgt);
+	return true;
 }
 
-void Pinball::InitSpinners()
+Transform Pinball::TablePose(const TableElement& element)
 {
-	// Actor Parameters
-	Spinner *lft, *rgt;
-	Transform pose;
-
-	Fl32 xOffset, zOffset;
-
-	// Right Spinner
-	xOffset = board->Center().x - 0.5f;
-	zOffset = board->Center().z;
-	pose = Transform(Vec3(xOffset, calcYOffset(zOffset) + (board->WallHeight()*2), zOffset));
-	lft = new Spinner(pose, m_materials.spinnerMaterial, m_materials.spinnerColor, m_materials.spinnerDensity, SpinnerType::CLOCKWISE);
-	m_actors.push_back(lft);
-
-	// Left Spinner
-	xOffset = board->Center().x + 0.7f;
-	zOffset = board->Center().z;
-	pose = Transform(Vec3(xOffset, calcYOffset(zOffset) + (board->WallHeight()*2), zOffset));
-	rgt = new Spinner(pose, m_materials.spinnerMaterial, m_materials.spinnerColor, m_materials.spinnerDensity, SpinnerType::ANTICLOCKWISE);
-	m_actors.push_back(rgt);
+	Fl32 x = element.x;
+	switch ((TableAnchor)element.xAnchor)
+	{
+	case TableAnchor::Left:		x += board->Left().x;	break;
+	case TableAnchor::Right:	x += board->Right().x;	break;
+	default:					x += board->Center().x; break;
+	}
 
-	// Create Spinners Object
-	m_spinners = new Spinners(lft, rgt);
+	Fl32 z = element.z;
+	switch ((TableAnchor)element.zAnchor)
+	{
+	case TableAnchor::Top:		z += board->Top().z;	break;
+	case TableAnchor::Bottom:	z += board->Bottom().z; break;
+	default:					z += board->Center().z; break;
+	}
+
+	const float* r = element.rotation;
+	return Transform(Vec3(x, calcYOffset(z) + element.lift, z), Quat(r[0], r[1], r[2], r[3]));
 }
 
 void Pinball::InitSound()
 {
 	// Sound Effects
-	bumperSound = Sample("sfx/BumperSound.wav");
+	bumperSound = Sample("sfx/BumperSound.wav", m_bumperVoices);
 	enterSound = Sample("sfx/EnterSound.wav");
 	loseSound = Sample("sfx/LoseSound.wav");
 	switchSound = Sample("sfx/SwitchSound.wav");
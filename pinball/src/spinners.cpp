@@ -48,7 +48,7 @@ void Spinners::Update(Fl32 deltaTime)
 {
 	if (m_active)
 	{
-		m_timeActive += deltaTime*1000;
+		m_timeActive += deltaTime;
 		if (m_timeActive >= m_maxActiveTime)
 		{
 			Toggle();
@@ -0,0 +1,302 @@
+/*-------------------------------------------------------------------------\
+| File: TABLELAYOUT.CPP														|
+| Desc: Provides definitions for a pinball table layout, compiled from		|
+|		an editable text file into a flat binary loaded with one read.		|
+| Declaration File: TABLELAYOUT.H											|
+| Author: Henri Keeble														|
+\-------------------------------------------------------------------------*/
+#include "tableLayout.h"
+#include "log.h"
+#include "fileUtil.h"
+#include <Windows.h>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+
+static const unsigned int TABLE_MAGIC = 0x4C544250; // "PBTL"
+static const unsigned int TABLE_VERSION = 1;
+
+static const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+
+/* Start of a compiled table, its elements follow directly */
+struct TableHeader
+{
+	unsigned int magic;
+	unsigned int version;
+	unsigned long long sourceTime;
+	unsigned int count;
+	unsigned int elementSize;
+};
+
+static void LogCompileError(const std::string& sourcePath, int line, const std::string& message)
+{
+	Log::Write(("Err: " + sourcePath + " (" + std::to_string(line) + "): " + message + "\n").c_str(), ENGINE_LOG);
+}
+
+static bool ParseKind(const std::string& token, TableElementKind& kind)
+{
+	if (token == "wedge")		  kind = TableElementKind::Wedge;
+	else if (token == "bumper")	  kind = TableElementKind::Bumper;
+	else if (token == "spinner")  kind = TableElementKind::Spinner;
+	else if (token == "switch")	  kind = TableElementKind::Switch;
+	else return false;
+	return true;
+}
+
+static bool ParseVariant(TableElementKind kind, const std::string& token, unsigned short& variant)
+{
+	switch (kind)
+	{
+	case TableElementKind::Bumper:
+		if (token == "high")				variant = (unsigned short)BumperVariant::High;
+		else if (token == "low")			variant = (unsigned short)BumperVariant::Low;
+		else return false;
+		return true;
+	case TableElementKind::Spinner:
+		if (token == "clockwise")			variant = (unsigned short)SpinnerVariant::Clockwise;
+		else if (token == "anticlockwise")	variant = (unsigned short)SpinnerVariant::Anticlockwise;
+		else return false;
+		return true;
+	default:
+		variant = 0;
+		return token == "-";
+	}
+}
+
+// x offsets are measured from the center, left or right, z offsets from the center, top or bottom
+static bool ParseAnchor(const std::string& token, bool xAxis, unsigned char& anchor)
+{
+	if (token == "center")				 anchor = (unsigned char)TableAnchor::Center;
+	else if (xAxis && token == "left")	 anchor = (unsigned char)TableAnchor::Left;
+	else if (xAxis && token == "right")	 anchor = (unsigned char)TableAnchor::Right;
+	else if (!xAxis && token == "top")	 anchor = (unsigned char)TableAnchor::Top;
+	else if (!xAxis && token == "bottom") anchor = (unsigned char)TableAnchor::Bottom;
+	else return false;
+	return true;
+}
+
+static unsigned int CountKind(const TableElement* elements, unsigned int count, TableElementKind kind)
+{
+	unsigned int found = 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (elements[i].kind == (unsigned short)kind)
+			found++;
+	}
+	return found;
+}
+
+// The game drives its spinners and switches in pairs
+static bool IsPlayable(const TableElement* elements, unsigned int count)
+{
+	return CountKind(elements, count, TableElementKind::Spinner) == 2 && CountKind(elements, count, TableElementKind::Switch) == 2;
+}
+
+// Multiplies quaternion a by b (x, y, z, w), so b's rotation is applied first
+static void MultiplyRotation(const float a[4], const float b[4], float result[4])
+{
+	float r[4] =
+	{
+		a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+		a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0],
+		a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3],
+		a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2]
+	};
+	for (int i = 0; i < 4; i++)
+		result[i] = r[i];
+}
+
+/*-------------------------------------------------------------------------\
+|							TABLE LAYOUT DEFINITIONS						|
+\-------------------------------------------------------------------------*/
+TableLayout::TableLayout()
+{
+	m_elements = nullptr;
+	m_count = 0;
+}
+
+TableLayout::~TableLayout()
+{
+
+}
+
+bool TableLayout::Load(const std::string& name)
+{
+	m_data.clear();
+	m_elements = nullptr;
+	m_count = 0;
+
+	std::string sourcePath = SourcePath(name);
+	std::string binaryPath = BinaryPath(name);
+	unsigned long long sourceTime = GameFramework::ModifiedTime(sourcePath);
+
+	// Try the binary as it is first, then once more after rebuilding it from the source. A binary without a source is used as is.
+	for (int attempt = 0; attempt < 2; attempt++)
+	{
+		if (attempt == 1 && (sourceTime == 0 || !Compile(sourcePath, binaryPath)))
+			break;
+
+		std::ifstream file(binaryPath.c_str(), std::ios::binary);
+		if (!file)
+			continue;
+
+		file.seekg(0, std::ios::end);
+		std::streamoff size = file.tellg();
+		file.seekg(0, std::ios::beg);
+		if (size < (std::streamoff)sizeof(TableHeader))
+			continue;
+
+		m_data.resize((size_t)size);
+		if (!file.read(&m_data[0], size))
+			continue;
+
+		const TableHeader* header = (const TableHeader*)&m_data[0];
+		if (header->magic != TABLE_MAGIC || header->version != TABLE_VERSION || header->elementSize != sizeof(TableElement) ||
+			sizeof(TableHeader) + (unsigned long long)header->count * sizeof(TableElement) != (unsigned long long)size)
+			continue;
+
+		if (sourceTime != 0 && header->sourceTime != sourceTime)
+			continue; // Stale
+
+		const TableElement* elements = (const TableElement*)(&m_data[0] + sizeof(TableHeader));
+		if (!IsPlayable(elements, header->count))
+			continue;
+
+		m_elements = elements;
+		m_count = header->count;
+		return true;
+	}
+
+	m_data.clear();
+	Log::Write(("Err: Could not load table " + name + "!\n").c_str(), ENGINE_LOG);
+	return false;
+}
+
+unsigned int TableLayout::Count() const
+{
+	return m_count;
+}
+
+const TableElement* TableLayout::Elements() const
+{
+	return m_elements;
+}
+
+unsigned int TableLayout::Count(TableElementKind kind) const
+{
+	return CountKind(m_elements, m_count, kind);
+}
+
+bool TableLayout::Compile(const std::string& sourcePath, const std::string& binaryPath)
+{
+	Log::Write(("Compiling table " + sourcePath + "...\n").c_str(), ENGINE_LOG);
+
+	std::ifstream source(sourcePath.c_str());
+	if (!source)
+	{
+		Log::Write(("Err: Could not open table source " + sourcePath + "!\n").c_str(), ENGINE_LOG);
+		return false;
+	}
+
+	std::vector<TableElement> elements;
+	std::string text;
+	for (int line = 1; std::getline(source, text); line++)
+	{
+		// Comments run to the end of the line
+		size_t comment = text.find('#');
+		if (comment != std::string::npos)
+			text.erase(comment);
+
+		std::istringstream tokens(text);
+		std::string kindName, variantName, xAnchorName, zAnchorName;
+		if (!(tokens >> kindName))
+			continue; // Blank
+
+		TableElement element = TableElement();
+		TableElementKind kind;
+		if (!ParseKind(kindName, kind))
+		{
+			LogCompileError(sourcePath, line, "unknown element '" + kindName + "'");
+			return false;
+		}
+		element.kind = (unsigned short)kind;
+
+		if (!(tokens >> variantName) || !ParseVariant(kind, variantName, element.variant))
+		{
+			LogCompileError(sourcePath, line, "bad variant '" + variantName + "' for " + kindName);
+			return false;
+		}
+
+		if (!(tokens >> xAnchorName >> element.x >> zAnchorName >> element.z >> element.lift) ||
+			!ParseAnchor(xAnchorName, true, element.xAnchor) || !ParseAnchor(zAnchorName, false, element.zAnchor))
+		{
+			LogCompileError(sourcePath, line, "expected an anchored x and z, then a lift");
+			return false;
+		}
+
+		if (!(tokens >> element.scale[0] >> element.scale[1] >> element.scale[2]))
+		{
+			LogCompileError(sourcePath, line, "expected a scale");
+			return false;
+		}
+
+		// Any remaining tokens are axis and degree pairs, composed left to right
+		element.rotation[3] = 1.f;
+		std::string axis;
+		while (tokens >> axis)
+		{
+			float degrees = 0.f;
+			if ((axis != "x" && axis != "y" && axis != "z") || !(tokens >> degrees))
+			{
+				LogCompileError(sourcePath, line, "rotations are an axis (x, y or z) followed by degrees");
+				return false;
+			}
+
+			float half = degrees * DEGREES_TO_RADIANS * .5f;
+			float turn[4] = { 0.f, 0.f, 0.f, cosf(half) };
+			turn[axis[0] - 'x'] = sinf(half);
+			MultiplyRotation(element.rotation, turn, element.rotation);
+		}
+
+		elements.push_back(element);
+	}
+
+	if (elements.empty() || !IsPlayable(&elements[0], elements.size()))
+	{
+		Log::Write(("Err: " + sourcePath + ": a table needs exactly two spinners and two switches\n").c_str(), ENGINE_LOG);
+		return false;
+	}
+
+	std::string directory = GetCurrentDir();
+	directory.append(TABLE_DIR);
+	CreateDirectoryA(directory.c_str(), NULL);
+
+	GameFramework::AtomicFile file(binaryPath);
+	if (!file.IsOpen())
+		return false;
+
+	TableHeader header = { TABLE_MAGIC, TABLE_VERSION, GameFramework::ModifiedTime(sourcePath), (unsigned int)elements.size(), (unsigned int)sizeof(TableElement) };
+	file.Stream().write((const char*)&header, sizeof(header));
+	if (!elements.empty())
+		file.Stream().write((const char*)&elements[0], elements.size() * sizeof(TableElement));
+
+	return file.Commit();
+}
+
+std::string TableLayout::SourcePath(const std::string& name)
+{
+	std::string path = GetCurrentDir();
+	return path + TABLE_DIR "\\" + name + TABLE_SOURCE_EXT;
+}
+
+std::string TableLayout::BinaryPath(const std::string& name)
+{
+	std::string path = GetCurrentDir();
+	return path + TABLE_DIR "\\" + name + TABLE_BINARY_EXT;
+}
+
+std::string TableLayout::CachePath(const std::string& name)
+{
+	std::string path = GetCurrentDir();
+	return path + TABLE_DIR "\\" + name + TABLE_CACHE_EXT;
+}
@@ -1,8 +1,8 @@
 #include "pinball.h"
 
-ScoreCallback::ScoreCallback() : SimulationEventCallback()
+ScoreCallback::ScoreCallback(Sample* bumperSound) : SimulationEventCallback()
 {
-
+	m_bumperSound = bumperSound;
 }
 
 ScoreCallback::~ScoreCallback()
@@ -26,9 +26,10 @@ void ScoreCallback::onTrigger(PxTriggerPair* pairs, PxU32 count)
 					PxRigidDynamic* bumper = static_cast<PxRigidDynamic*>(pairs[i].triggerActor);
 
 					if (pairs[i].triggerActor->getName() == "BumperHigh")
-						Pinball::AddScoreHigh = true;
+						Pinball::HighBumperHits++;
 					else
-						Pinball::AddScoreLow = true;
+						Pinball::LowBumperHits++;
+					m_bumperSound->Play();
 
 					Transform bumperPose = bumper->getGlobalPose();
 					Transform ballPose = ball->getGlobalPose();